@@ -0,0 +1,197 @@
+/**
+ * @file Cobs.c
+ * @author Seb Madgwick
+ * @brief Consistent Overhead Byte Stuffing (COBS) framing. Frames are
+ * delimited by COBS_DELIMITER so that a UART DMA driver may use
+ * COBS_DELIMITER as the read termination byte and receive one frame per read
+ * callback.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Cobs.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum number of non-zero bytes encoded by a single code byte.
+ */
+#define MAX_GROUP_LENGTH (254)
+
+/**
+ * @brief Number of groups written to the write buffer per writev call.
+ */
+#define NUMBER_OF_GROUPS (8)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline __attribute__((always_inline)) void Append(CobsDecoder * const decoder, const uint8_t byte);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static const uint8_t delimiter = COBS_DELIMITER;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Encodes a frame and writes it to a write buffer. The encoded frame is
+ * written as vectors of code bytes and unmodified runs of the data so that no
+ * intermediate buffer is required. The frame is written using several writev
+ * calls so the write buffer must have no other writer. Either all or none of
+ * the frame will be written.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param availableWrite Available write function of the driver, e.g.
+ * Uart1DmaAvailableWrite or UsbCdcAvailableWrite.
+ * @param writev Writev function of the driver, e.g. Uart1DmaWritev or
+ * UsbCdcWritev.
+ * @return Result.
+ */
+FifoResult CobsWrite(const void* const data, const size_t numberOfBytes, size_t (*const availableWrite) (void), FifoResult (*const writev) (const FifoVector * const vectors, const size_t numberOfVectors)) {
+
+    // Ensure space available for largest encoded size
+    if (availableWrite() < (numberOfBytes + (numberOfBytes / MAX_GROUP_LENGTH) + 2)) {
+        return FifoResultError;
+    }
+
+    // Write groups
+    const uint8_t * const bytes = data;
+    uint8_t codes[NUMBER_OF_GROUPS];
+    FifoVector vectors[(2 * NUMBER_OF_GROUPS) + 1];
+    size_t numberOfGroups = 0;
+    size_t numberOfVectors = 0;
+    size_t index = 0;
+    while (true) {
+
+        // Find group of non-zero bytes
+        size_t length = 0;
+        while (((index + length) < numberOfBytes) && (bytes[index + length] != 0) && (length < MAX_GROUP_LENGTH)) {
+            length++;
+        }
+
+        // Add group
+        codes[numberOfGroups] = (uint8_t) (length + 1);
+        vectors[numberOfVectors++] = (FifoVector){.data = &codes[numberOfGroups++], .numberOfBytes = 1};
+        if (length > 0) {
+            vectors[numberOfVectors++] = (FifoVector){.data = &bytes[index], .numberOfBytes = length};
+        }
+        index += length;
+        const bool end = index == numberOfBytes;
+        if (end) {
+            vectors[numberOfVectors++] = (FifoVector){.data = &delimiter, .numberOfBytes = 1};
+        } else if (length < MAX_GROUP_LENGTH) {
+            index++; // skip zero replaced by code
+        }
+
+        // Write groups
+        if (end || (numberOfGroups == NUMBER_OF_GROUPS)) {
+            const FifoResult result = writev(vectors, numberOfVectors);
+            if ((result != FifoResultOk) || end) {
+                return result;
+            }
+            numberOfGroups = 0;
+            numberOfVectors = 0;
+        }
+    }
+}
+
+/**
+ * @brief Processes received data. The frame callback will be called for each
+ * valid frame.
+ * @param decoder Decoder structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void CobsDecoderProcess(CobsDecoder * const decoder, const void* const data, const size_t numberOfBytes) {
+    const uint8_t * const bytes = data;
+    size_t index = 0;
+    while (index < numberOfBytes) {
+
+        // Copy remaining bytes of group
+        size_t length = decoder->count;
+        if (length > (numberOfBytes - index)) {
+            length = numberOfBytes - index;
+        }
+        if (length > (decoder->dataSize - decoder->index)) {
+            length = decoder->dataSize - decoder->index;
+        }
+        const uint8_t * const delimiterPointer = memchr(&bytes[index], COBS_DELIMITER, length);
+        if (delimiterPointer != NULL) {
+            length = delimiterPointer - &bytes[index];
+        }
+        memcpy(&decoder->data[decoder->index], &bytes[index], length);
+        decoder->index += length;
+        decoder->count -= length;
+        index += length;
+
+        // Process code byte, delimiter or overflowing byte
+        if (index < numberOfBytes) {
+            CobsDecoderProcessByte(decoder, bytes[index++]);
+        }
+    }
+}
+
+/**
+ * @brief Processes a received byte. The frame callback will be called if the
+ * byte completes a valid frame.
+ * @param decoder Decoder structure.
+ * @param byte Byte.
+ */
+void CobsDecoderProcessByte(CobsDecoder * const decoder, const uint8_t byte) {
+
+    // Delimiter
+    if (byte == COBS_DELIMITER) {
+        if ((decoder->code != 0) && (decoder->count == 0) && (decoder->error == false)) {
+            decoder->frame(decoder->data, decoder->index);
+        }
+        CobsDecoderClear(decoder);
+        return;
+    }
+
+    // Code byte
+    if (decoder->count == 0) {
+        if ((decoder->code != 0) && (decoder->code != (MAX_GROUP_LENGTH + 1))) {
+            Append(decoder, 0); // zero replaced by previous code
+        }
+        decoder->code = byte;
+        decoder->count = byte - 1;
+        return;
+    }
+
+    // Data byte
+    Append(decoder, byte);
+    decoder->count--;
+}
+
+/**
+ * @brief Appends a byte to the frame.
+ * @param decoder Decoder structure.
+ * @param byte Byte.
+ */
+static inline __attribute__((always_inline)) void Append(CobsDecoder * const decoder, const uint8_t byte) {
+    if (decoder->index >= decoder->dataSize) {
+        decoder->error = true;
+        return;
+    }
+    decoder->data[decoder->index++] = byte;
+}
+
+/**
+ * @brief Discards any partially received frame.
+ * @param decoder Decoder structure.
+ */
+void CobsDecoderClear(CobsDecoder * const decoder) {
+    decoder->index = 0;
+    decoder->code = 0;
+    decoder->count = 0;
+    decoder->error = false;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,59 @@
+/**
+ * @file Cobs.h
+ * @author Seb Madgwick
+ * @brief Consistent Overhead Byte Stuffing (COBS) framing. Frames are
+ * delimited by COBS_DELIMITER so that a UART DMA driver may use
+ * COBS_DELIMITER as the read termination byte and receive one frame per read
+ * callback. An encoded frame is written to the destination write buffer using
+ * several writev calls. The write buffer must therefore have exactly one
+ * writer. Frames may be interleaved with other data if the write buffer is
+ * shared, for example, with SdCardLoggerWritev or a second producer.
+ */
+
+#ifndef COBS_H
+#define COBS_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Frame delimiter.
+ */
+#define COBS_DELIMITER (0x00)
+
+/**
+ * @brief Decoder structure. The data, data size and frame callback must be
+ * initialised by the user. The frame callback is called with the decoded
+ * frame each time a valid frame is received. Frames larger than the data size
+ * are discarded. All other structure members are private.
+ */
+typedef struct {
+    uint8_t * const data;
+    const size_t dataSize;
+    void (*const frame) (const void* const data, const size_t numberOfBytes);
+    size_t index;
+    uint8_t code;
+    uint8_t count;
+    bool error;
+} CobsDecoder;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+FifoResult CobsWrite(const void* const data, const size_t numberOfBytes, size_t (*const availableWrite) (void), FifoResult (*const writev) (const FifoVector * const vectors, const size_t numberOfVectors));
+void CobsDecoderProcess(CobsDecoder * const decoder, const void* const data, const size_t numberOfBytes);
+void CobsDecoderProcessByte(CobsDecoder * const decoder, const uint8_t byte);
+void CobsDecoderClear(CobsDecoder * const decoder);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
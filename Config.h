@@ -96,39 +96,63 @@
 
 #define SYNC_INPUT_CAPTURE                 		inputCapture1
 
+//#define UART1_DMA_PING_PONG
+//#define UART1_DMA_READ_STREAM
+//#define UART1_DMA_READ_DEFERRED
 //#define UART1_DMA_TIMEOUT_POLL
-#define UART1_READ_BUFFER_SIZE             		(4096)
-#define UART1_WRITE_BUFFER_SIZE            		(4096)
+#define UART1_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART1_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART1_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART1_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
+//#define UART2_DMA_PING_PONG
+//#define UART2_DMA_READ_STREAM
+//#define UART2_DMA_READ_DEFERRED
 //#define UART2_DMA_TIMEOUT_POLL
-#define UART2_READ_BUFFER_SIZE             		(4096)
-#define UART2_WRITE_BUFFER_SIZE            		(4096)
+#define UART2_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART2_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART2_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART2_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART2_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
+//#define UART3_DMA_PING_PONG
+//#define UART3_DMA_READ_STREAM
+//#define UART3_DMA_READ_DEFERRED
 //#define UART3_DMA_TIMEOUT_POLL
-#define UART3_READ_BUFFER_SIZE             		(4096)
-#define UART3_WRITE_BUFFER_SIZE            		(4096)
+#define UART3_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART3_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART3_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART3_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
+//#define UART4_DMA_PING_PONG
+//#define UART4_DMA_READ_STREAM
+//#define UART4_DMA_READ_DEFERRED
 //#define UART4_DMA_TIMEOUT_POLL
-#define UART4_READ_BUFFER_SIZE             		(4096)
-#define UART4_WRITE_BUFFER_SIZE            		(4096)
+#define UART4_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART4_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART4_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART4_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART4_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
+//#define UART5_DMA_PING_PONG
+//#define UART5_DMA_READ_STREAM
+//#define UART5_DMA_READ_DEFERRED
 //#define UART5_DMA_TIMEOUT_POLL
-#define UART5_READ_BUFFER_SIZE             		(4096)
-#define UART5_WRITE_BUFFER_SIZE            		(4096)
+#define UART5_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART5_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART5_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART5_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART5_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
+//#define UART6_DMA_PING_PONG
+//#define UART6_DMA_READ_STREAM
+//#define UART6_DMA_READ_DEFERRED
 //#define UART6_DMA_TIMEOUT_POLL
-#define UART6_READ_BUFFER_SIZE             		(4096)
-#define UART6_WRITE_BUFFER_SIZE            		(4096)
+#define UART6_READ_BUFFER_SIZE             		(4096) // must be a power of two
+#define UART6_WRITE_BUFFER_SIZE            		(4096) // must be a power of two
+#define UART6_DMA_HIGH_PRIORITY_BUFFER_SIZE		(256) // 0 if unused
 #define UART6_DMA_READ_TRANSFER_SIZE       		(1024)
 #define UART6_DMA_WRITE_TRANSFER_SIZE      		(1024)
 
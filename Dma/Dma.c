@@ -0,0 +1,172 @@
+/**
+ * @file Dma.c
+ * @author Seb Madgwick
+ * @brief DMA channel manager for PIC32 devices. DMA channels are allocated to
+ * drivers at run time and the DMA interrupts are dispatched to the interrupt
+ * handler of the owner of each channel.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include "Dma.h"
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline __attribute__((always_inline)) void InterruptHandler(const DmaChannel * const channel);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static DmaChannel channels[DMA_NUMBER_OF_CHANNELS] = {
+    {.registers = (DmaRegisters*) &DCH0CON, .interruptSource = INT_SOURCE_DMA0},
+    {.registers = (DmaRegisters*) &DCH1CON, .interruptSource = INT_SOURCE_DMA1},
+    {.registers = (DmaRegisters*) &DCH2CON, .interruptSource = INT_SOURCE_DMA2},
+    {.registers = (DmaRegisters*) &DCH3CON, .interruptSource = INT_SOURCE_DMA3},
+#if DMA_NUMBER_OF_CHANNELS > 4
+    {.registers = (DmaRegisters*) &DCH4CON, .interruptSource = INT_SOURCE_DMA4},
+    {.registers = (DmaRegisters*) &DCH5CON, .interruptSource = INT_SOURCE_DMA5},
+    {.registers = (DmaRegisters*) &DCH6CON, .interruptSource = INT_SOURCE_DMA6},
+    {.registers = (DmaRegisters*) &DCH7CON, .interruptSource = INT_SOURCE_DMA7},
+#endif
+};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Allocates a DMA channel. The channel registers will be in their
+ * default states and the channel interrupt will be disabled.
+ * @param interruptHandler Interrupt handler. NULL if unused.
+ * @return DMA channel. NULL if no channels are available.
+ */
+DmaChannel* DmaAllocate(void (*const interruptHandler) (void)) {
+    for (int index = 0; index < DMA_NUMBER_OF_CHANNELS; index++) {
+        DmaChannel * const channel = &channels[index];
+        if (channel->allocated) {
+            continue;
+        }
+        channel->allocated = true;
+        channel->interruptHandler = interruptHandler;
+        DMACONbits.ON = 1; // enable DMA
+        return channel;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Disables a DMA channel, restores the default register states and
+ * frees the channel.
+ * @param channel DMA channel. May be NULL.
+ */
+void DmaFree(DmaChannel * const channel) {
+    if (channel == NULL) {
+        return;
+    }
+
+    // Disable channel and restore default register states
+    channel->registers->DCHxCON = 0;
+    channel->registers->DCHxECON = 0;
+    channel->registers->DCHxINT = 0;
+    channel->registers->DCHxSSA = 0;
+    channel->registers->DCHxDSA = 0;
+    channel->registers->DCHxSSIZ = 0;
+    channel->registers->DCHxDSIZ = 0;
+    channel->registers->DCHxSPTR = 0;
+    channel->registers->DCHxDPTR = 0;
+    channel->registers->DCHxCSIZ = 0;
+    channel->registers->DCHxCPTR = 0;
+    channel->registers->DCHxDAT = 0;
+
+    // Disable interrupt
+    EVIC_SourceDisable(channel->interruptSource);
+    EVIC_SourceStatusClear(channel->interruptSource);
+
+    // Free channel
+    channel->interruptHandler = NULL;
+    channel->allocated = false;
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma0InterruptHandler(void) {
+    InterruptHandler(&channels[0]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma1InterruptHandler(void) {
+    InterruptHandler(&channels[1]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma2InterruptHandler(void) {
+    InterruptHandler(&channels[2]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma3InterruptHandler(void) {
+    InterruptHandler(&channels[3]);
+}
+#if DMA_NUMBER_OF_CHANNELS > 4
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma4InterruptHandler(void) {
+    InterruptHandler(&channels[4]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma5InterruptHandler(void) {
+    InterruptHandler(&channels[5]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma6InterruptHandler(void) {
+    InterruptHandler(&channels[6]);
+}
+
+/**
+ * @brief DMA interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
+ */
+void Dma7InterruptHandler(void) {
+    InterruptHandler(&channels[7]);
+}
+#endif
+
+/**
+ * @brief Calls the interrupt handler of the owner of the channel.
+ * @param channel DMA channel.
+ */
+static inline __attribute__((always_inline)) void InterruptHandler(const DmaChannel * const channel) {
+    if (channel->interruptHandler != NULL) {
+        channel->interruptHandler();
+    } else {
+        EVIC_SourceStatusClear(channel->interruptSource);
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
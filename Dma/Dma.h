@@ -0,0 +1,114 @@
+/**
+ * @file Dma.h
+ * @author Seb Madgwick
+ * @brief DMA channel manager for PIC32 devices.
+ */
+
+#ifndef DMA_H
+#define DMA_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of DMA channels. PIC32MX1xx/2xx/3xx/4xx devices have four
+ * channels.
+ */
+#ifdef _DCH7CON_CHEN_POSITION
+#define DMA_NUMBER_OF_CHANNELS (8)
+#else
+#define DMA_NUMBER_OF_CHANNELS (4)
+#endif
+
+/**
+ * @brief DMA channel registers. The register layout is the same for all
+ * channels.
+ */
+typedef struct {
+    union {
+        volatile uint32_t DCHxCON;
+        volatile __DCH0CONbits_t DCHxCONbits;
+    };
+    volatile uint32_t DCHxCONCLR;
+    volatile uint32_t DCHxCONSET;
+    volatile uint32_t DCHxCONINV;
+    union {
+        volatile uint32_t DCHxECON;
+        volatile __DCH0ECONbits_t DCHxECONbits;
+    };
+    volatile uint32_t DCHxECONCLR;
+    volatile uint32_t DCHxECONSET;
+    volatile uint32_t DCHxECONINV;
+    union {
+        volatile uint32_t DCHxINT;
+        volatile __DCH0INTbits_t DCHxINTbits;
+    };
+    volatile uint32_t DCHxINTCLR;
+    volatile uint32_t DCHxINTSET;
+    volatile uint32_t DCHxINTINV;
+    volatile uint32_t DCHxSSA;
+    volatile uint32_t DCHxSSACLR;
+    volatile uint32_t DCHxSSASET;
+    volatile uint32_t DCHxSSAINV;
+    volatile uint32_t DCHxDSA;
+    volatile uint32_t DCHxDSACLR;
+    volatile uint32_t DCHxDSASET;
+    volatile uint32_t DCHxDSAINV;
+    volatile uint32_t DCHxSSIZ;
+    volatile uint32_t DCHxSSIZCLR;
+    volatile uint32_t DCHxSSIZSET;
+    volatile uint32_t DCHxSSIZINV;
+    volatile uint32_t DCHxDSIZ;
+    volatile uint32_t DCHxDSIZCLR;
+    volatile uint32_t DCHxDSIZSET;
+    volatile uint32_t DCHxDSIZINV;
+    volatile uint32_t DCHxSPTR;
+    volatile uint32_t DCHxSPTRCLR;
+    volatile uint32_t DCHxSPTRSET;
+    volatile uint32_t DCHxSPTRINV;
+    volatile uint32_t DCHxDPTR;
+    volatile uint32_t DCHxDPTRCLR;
+    volatile uint32_t DCHxDPTRSET;
+    volatile uint32_t DCHxDPTRINV;
+    volatile uint32_t DCHxCSIZ;
+    volatile uint32_t DCHxCSIZCLR;
+    volatile uint32_t DCHxCSIZSET;
+    volatile uint32_t DCHxCSIZINV;
+    volatile uint32_t DCHxCPTR;
+    volatile uint32_t DCHxCPTRCLR;
+    volatile uint32_t DCHxCPTRSET;
+    volatile uint32_t DCHxCPTRINV;
+    volatile uint32_t DCHxDAT;
+    volatile uint32_t DCHxDATCLR;
+    volatile uint32_t DCHxDATSET;
+    volatile uint32_t DCHxDATINV;
+} DmaRegisters;
+
+/**
+ * @brief DMA channel. The registers and interrupt source may be used by the
+ * owner of the channel. All other structure members are private.
+ */
+typedef struct {
+    DmaRegisters * const registers;
+    const INT_SOURCE interruptSource;
+    void (*interruptHandler)(void);
+    bool allocated;
+} DmaChannel;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+DmaChannel* DmaAllocate(void (*const interruptHandler) (void));
+void DmaFree(DmaChannel * const channel);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
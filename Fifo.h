@@ -33,6 +33,8 @@ typedef struct {
     const size_t dataSize;
     volatile size_t writeIndex;
     volatile size_t readIndex;
+    volatile size_t reserveIndex;
+    volatile int writesInProgress;
 } Fifo;
 
 /**
@@ -43,6 +45,193 @@ typedef enum {
     FifoResultError,
 } FifoResult;
 
+/**
+ * @brief Vector element of data to be written to the FIFO.
+ *
+ * Example:
+ * @code
+ * const FifoVector vectors[] = {
+ *     {.data = &header, .numberOfBytes = sizeof (header)},
+ *     {.data = payload, .numberOfBytes = payloadSize},
+ *     {.data = &crc, .numberOfBytes = sizeof (crc)},
+ * };
+ * FifoWritev(&fifo, vectors, sizeof (vectors) / sizeof (FifoVector));
+ * @endcode
+ */
+typedef struct {
+    const void* data;
+    size_t numberOfBytes;
+} FifoVector;
+
+/**
+ * @brief Power-of-two FIFO structure. The data size must be a power of two so
+ * that indexes can be free-running and masked instead of compared and wrapped.
+ * The capacity is equal to the data size. All structure members are private
+ * except for initialisation.
+ *
+ * Example:
+ * @code
+ * uint8_t data[1024];
+ * FifoPow2 fifo = {.data = data, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (data))};
+ * @endcode
+ */
+typedef struct {
+    volatile uint8_t * const data;
+    const size_t dataSize;
+    volatile size_t writeIndex;
+    volatile size_t readIndex;
+} FifoPow2;
+
+/**
+ * @brief Broadcast FIFO reader structure. All structure members are private.
+ */
+typedef struct {
+    volatile size_t readIndex;
+    volatile uint32_t dropCount; // written by writer
+    uint32_t dropCountAcknowledged; // written by reader
+    uint32_t numberOfDrops;
+} FifoBroadcastReader;
+
+/**
+ * @brief Broadcast FIFO structure. A single writer and multiple readers share
+ * the same data. Each reader has an independent read index and the space
+ * available to write is limited by the slowest reader. If dropSlowReaders is
+ * true then readers that would prevent a write are dropped and resume from the
+ * newest data. All structure members are private except for initialisation.
+ *
+ * Example:
+ * @code
+ * uint8_t data[4096];
+ * FifoBroadcastReader readers[3];
+ * FifoBroadcast fifo = {.data = data, .dataSize = sizeof (data), .readers = readers, .numberOfReaders = sizeof (readers) / sizeof (FifoBroadcastReader)};
+ * @endcode
+ */
+typedef struct {
+    volatile uint8_t * const data;
+    const size_t dataSize;
+    FifoBroadcastReader * const readers;
+    const size_t numberOfReaders;
+    const bool dropSlowReaders;
+    volatile size_t writeIndex;
+} FifoBroadcast;
+
+/**
+ * @brief Bi-partite (bip) FIFO structure. Data is always written and read as
+ * contiguous blocks so that it may be transferred directly by DMA. A write
+ * that does not fit at the end of the buffer is written to the start of the
+ * buffer and the unused space at the end is skipped by the reader. All
+ * structure members are private except for initialisation.
+ *
+ * Example:
+ * @code
+ * uint8_t data[1024];
+ * FifoBip fifo = {.data = data, .dataSize = sizeof (data)};
+ * @endcode
+ */
+typedef struct {
+    volatile uint8_t * const data;
+    const size_t dataSize;
+    volatile size_t writeIndex;
+    volatile size_t readIndex;
+    volatile size_t endIndex; // end of data while write index is before read index
+    size_t reserveIndex;
+} FifoBip;
+
+/**
+ * @brief Evaluates to the data size. Compilation will fail if the data size is
+ * not a power of two.
+ * @param dataSize Data size.
+ */
+#define FIFO_POW2_DATA_SIZE(dataSize) ((dataSize) * sizeof (char[(((dataSize) != 0) && (((dataSize) & ((dataSize) - 1)) == 0)) ? 1 : -1]))
+
+/**
+ * @brief Defines a typed FIFO structure and functions for fixed-size elements.
+ * Elements are stored naturally aligned and copied by value. The FIFO
+ * structure must be zero-initialised. The functions defined are:
+ * nameAvailableRead, nameRead, nameAvailableWrite, nameWrite,
+ * nameWriteOverwrite, and nameClear. nameWriteOverwrite discards the oldest
+ * elements if the FIFO is full and returns the number of elements discarded.
+ * @param name Name of the FIFO structure and prefix of the functions.
+ * @param type Element type.
+ * @param capacity Capacity in number of elements.
+ *
+ * Example:
+ * @code
+ * FIFO_TYPED(SampleFifo, Sample, 128)
+ * static SampleFifo fifo;
+ * SampleFifoWrite(&fifo, &sample);
+ * @endcode
+ */
+#define FIFO_TYPED(name, type, capacity) \
+typedef struct { \
+    type elements[(capacity) + 1]; \
+    volatile size_t writeIndex; \
+    volatile size_t readIndex; \
+} name; \
+\
+static inline __attribute__((always_inline)) size_t name##NextIndex(const size_t index) { \
+    return index == (capacity) ? 0 : index + 1; \
+} \
+\
+static inline __attribute__((always_inline)) size_t name##AvailableRead(name * const fifo) { \
+    const size_t writeIndex = fifo->writeIndex; /* avoid asynchronous hazard */ \
+    const size_t readIndex = fifo->readIndex; \
+    return writeIndex < readIndex ? (capacity) + 1 - readIndex + writeIndex : writeIndex - readIndex; \
+} \
+\
+static inline __attribute__((always_inline)) FifoResult name##Read(name * const fifo, type * const element) { \
+    while (true) { \
+        const size_t readIndex = fifo->readIndex; \
+        if (readIndex == fifo->writeIndex) { \
+            return FifoResultError; \
+        } \
+        __sync_synchronize(); /* write index must be read before element */ \
+        *element = fifo->elements[readIndex]; \
+        if (__sync_bool_compare_and_swap(&fifo->readIndex, readIndex, name##NextIndex(readIndex))) { \
+            return FifoResultOk; /* element was not discarded during read */ \
+        } \
+    } \
+} \
+\
+static inline __attribute__((always_inline)) size_t name##AvailableWrite(name * const fifo) { \
+    return (capacity) - name##AvailableRead(fifo); \
+} \
+\
+static inline __attribute__((always_inline)) FifoResult name##Write(name * const fifo, const type * const element) { \
+    const size_t writeIndex = fifo->writeIndex; \
+    const size_t nextWriteIndex = name##NextIndex(writeIndex); \
+    if (nextWriteIndex == fifo->readIndex) { \
+        return FifoResultError; \
+    } \
+    fifo->elements[writeIndex] = *element; \
+    __sync_synchronize(); /* element must be written before write index */ \
+    fifo->writeIndex = nextWriteIndex; \
+    return FifoResultOk; \
+} \
+\
+static inline __attribute__((always_inline)) uint32_t name##WriteOverwrite(name * const fifo, const type * const element) { \
+    const size_t writeIndex = fifo->writeIndex; \
+    const size_t nextWriteIndex = name##NextIndex(writeIndex); \
+    uint32_t numberOfElementsDiscarded = 0; \
+    while (true) { \
+        const size_t readIndex = fifo->readIndex; \
+        if (nextWriteIndex != readIndex) { \
+            break; \
+        } \
+        if (__sync_bool_compare_and_swap(&fifo->readIndex, readIndex, name##NextIndex(readIndex))) { \
+            numberOfElementsDiscarded++; \
+        } \
+    } \
+    fifo->elements[writeIndex] = *element; \
+    __sync_synchronize(); /* element must be written before write index */ \
+    fifo->writeIndex = nextWriteIndex; \
+    return numberOfElementsDiscarded; \
+} \
+\
+static inline __attribute__((always_inline)) void name##Clear(name * const fifo) { \
+    fifo->readIndex = fifo->writeIndex; \
+}
+
 //------------------------------------------------------------------------------
 // Inline functions
 
@@ -148,6 +337,128 @@ static inline __attribute__((always_inline)) void FifoReadPointerComplete(Fifo *
     }
 }
 
+/**
+ * @brief Reads data from the FIFO without removing it from the FIFO.
+ * @param fifo FIFO structure.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+static inline __attribute__((always_inline)) size_t FifoPeek(Fifo * const fifo, void* const destination, size_t numberOfBytes) {
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = FifoAvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Read data
+    const size_t readIndex = fifo->readIndex;
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    if (numberOfBytes <= numberOfBytesBeforeWraparound) {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytes);
+    } else {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytesBeforeWraparound);
+        memcpy(&((uint8_t*) destination)[numberOfBytesBeforeWraparound], (void*) fifo->data, numberOfBytes - numberOfBytesBeforeWraparound);
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Removes data from the FIFO without reading it.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes removed.
+ */
+static inline __attribute__((always_inline)) size_t FifoSkip(Fifo * const fifo, size_t numberOfBytes) {
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = FifoAvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Update read index
+    size_t readIndex = fifo->readIndex + numberOfBytes;
+    if (readIndex >= fifo->dataSize) {
+        readIndex -= fifo->dataSize;
+    }
+    fifo->readIndex = readIndex;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of a byte in a block of
+ * data. The data is compared one word at a time. This function is private.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param byte Byte.
+ * @return Index of the byte. Equal to the number of bytes if not found.
+ */
+static inline __attribute__((always_inline)) size_t FifoFindInternal(const uint8_t * const data, const size_t numberOfBytes, const uint8_t byte) {
+    size_t index = 0;
+
+    // Compare bytes until word aligned
+    while ((index < numberOfBytes) && ((((uintptr_t) &data[index]) % sizeof (uint32_t)) != 0)) {
+        if (data[index] == byte) {
+            return index;
+        }
+        index++;
+    }
+
+    // Compare words until word contains byte
+    const uint32_t pattern = 0x01010101UL * byte;
+    while ((index + sizeof (uint32_t)) <= numberOfBytes) {
+        uint32_t word;
+        memcpy(&word, &data[index], sizeof (word));
+        word ^= pattern; // bytes equal to byte become zero
+        if (((word - 0x01010101UL) & ~word & 0x80808080UL) != 0) { // if word contains zero byte
+            break;
+        }
+        index += sizeof (uint32_t);
+    }
+
+    // Compare remaining bytes
+    while (index < numberOfBytes) {
+        if (data[index] == byte) {
+            return index;
+        }
+        index++;
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the FIFO. The data is not
+ * removed from the FIFO.
+ * @param fifo FIFO structure.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result. FifoResultError if the byte was not found.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoFind(Fifo * const fifo, const uint8_t byte, size_t * const offset) {
+    const size_t readIndex = fifo->readIndex;
+    const size_t writeIndex = fifo->writeIndex; // avoid asynchronous hazard
+
+    // Search data before wraparound
+    const size_t numberOfBytesBeforeWraparound = (writeIndex < readIndex ? fifo->dataSize : writeIndex) - readIndex;
+    *offset = FifoFindInternal((uint8_t*) &fifo->data[readIndex], numberOfBytesBeforeWraparound, byte);
+    if (*offset < numberOfBytesBeforeWraparound) {
+        return FifoResultOk;
+    }
+    if (writeIndex >= readIndex) {
+        return FifoResultError;
+    }
+
+    // Search data after wraparound
+    const size_t index = FifoFindInternal((uint8_t*) fifo->data, writeIndex, byte);
+    if (index == writeIndex) {
+        return FifoResultError;
+    }
+    *offset = numberOfBytesBeforeWraparound + index;
+    return FifoResultOk;
+}
+
 /**
  * @brief Returns the size of the next packet in the FIFO. This function must
  * only be used if all data in the FIFO was written using FifoWritePacket.
@@ -269,6 +580,45 @@ static inline __attribute__((always_inline)) FifoResult FifoWrite(Fifo * const f
     return FifoResultOk;
 }
 
+/**
+ * @brief Returns the total number of bytes of a vector. This function is
+ * private.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Total number of bytes.
+ */
+static inline __attribute__((always_inline)) size_t FifoVectorsSize(const FifoVector * const vectors, const size_t numberOfVectors) {
+    size_t numberOfBytes = 0;
+    for (size_t index = 0; index < numberOfVectors; index++) {
+        numberOfBytes += vectors[index].numberOfBytes;
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Writes a vector of data to the FIFO. Either all or none of the data
+ * will be written.
+ * @param fifo FIFO structure.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoWritev(Fifo * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+
+    // Do nothing if not enough space available
+    if (FifoVectorsSize(vectors, numberOfVectors) > FifoAvailableWrite(fifo)) {
+        return FifoResultError;
+    }
+
+    // Write data
+    size_t writeIndex = fifo->writeIndex;
+    for (size_t index = 0; index < numberOfVectors; index++) {
+        writeIndex = FifoWriteInternal(fifo, vectors[index].data, vectors[index].numberOfBytes, writeIndex);
+    }
+    fifo->writeIndex = writeIndex;
+    return FifoResultOk;
+}
+
 /**
  * @brief Writes a byte to the FIFO.
  * @param fifo FIFO structure.
@@ -290,6 +640,38 @@ static inline __attribute__((always_inline)) FifoResult FifoWriteByte(Fifo * con
     return FifoResultOk;
 }
 
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the FIFO.
+ * FifoWritePointerComplete must be called after data has been written.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoWritePointer(Fifo * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    *pointer = (void*) &fifo->data[fifo->writeIndex];
+    const size_t readIndex = fifo->readIndex; // avoid asynchronous hazard
+    if (readIndex > fifo->writeIndex) {
+        *numberOfBytes = readIndex - fifo->writeIndex - 1;
+    } else if (readIndex == 0) {
+        *numberOfBytes = fifo->dataSize - fifo->writeIndex - 1; // write index must not wraparound to read index
+    } else {
+        *numberOfBytes = fifo->dataSize - fifo->writeIndex;
+    }
+}
+
+/**
+ * @brief Updates the FIFO after FifoWritePointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoWritePointerComplete(Fifo * const fifo, const size_t numberOfBytes) {
+    size_t writeIndex = fifo->writeIndex + numberOfBytes;
+    if (writeIndex >= fifo->dataSize) {
+        writeIndex = 0;
+    }
+    fifo->writeIndex = writeIndex; // write index must only be updated once data is written
+}
+
 /**
  * @brief Returns the space available to write a packet to the FIFO.
  * @param fifo FIFO structure.
@@ -305,13 +687,14 @@ static inline __attribute__((always_inline)) size_t FifoAvailableWritePacket(Fif
 }
 
 /**
- * @brief Writes a packet to the FIFO.
+ * @brief Writes a vector of data to the FIFO as a single packet.
  * @param fifo FIFO structure.
- * @param data Data.
- * @param numberOfBytes Number of bytes.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
  * @return Result.
  */
-static inline __attribute__((always_inline)) FifoResult FifoWritePacket(Fifo * const fifo, const void* const data, const size_t numberOfBytes) {
+static inline __attribute__((always_inline)) FifoResult FifoWritePacketv(Fifo * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+    const size_t numberOfBytes = FifoVectorsSize(vectors, numberOfVectors);
     if (numberOfBytes == 0) {
         return FifoResultError;
     }
@@ -327,10 +710,111 @@ static inline __attribute__((always_inline)) FifoResult FifoWritePacket(Fifo * c
     }
     const uint16_t packetSize = (uint16_t) numberOfBytes;
     writeIndex = FifoWriteInternal(fifo, &packetSize, sizeof (packetSize), writeIndex);
-    fifo->writeIndex = FifoWriteInternal(fifo, data, numberOfBytes, writeIndex);
+    for (size_t index = 0; index < numberOfVectors; index++) {
+        writeIndex = FifoWriteInternal(fifo, vectors[index].data, vectors[index].numberOfBytes, writeIndex);
+    }
+    fifo->writeIndex = writeIndex;
     return FifoResultOk;
 }
 
+/**
+ * @brief Writes a packet to the FIFO.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoWritePacket(Fifo * const fifo, const void* const data, const size_t numberOfBytes) {
+    const FifoVector vector = {.data = data, .numberOfBytes = numberOfBytes};
+    return FifoWritePacketv(fifo, &vector, 1);
+}
+
+/**
+ * @brief Returns the space available to write to the FIFO. This function must
+ * only be used if all data in the FIFO is written using
+ * FifoWritevMultiProducer or FifoWriteMultiProducer.
+ * @param fifo FIFO structure.
+ * @return Space available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoAvailableWriteMultiProducer(Fifo * const fifo) {
+    const size_t readIndex = fifo->readIndex; // avoid asynchronous hazard
+    const size_t reserveIndex = fifo->reserveIndex;
+    if (reserveIndex < readIndex) {
+        return FifoCapacity(fifo) - (fifo->dataSize - readIndex) - reserveIndex;
+    } else {
+        return FifoCapacity(fifo) - (reserveIndex - readIndex);
+    }
+}
+
+/**
+ * @brief Writes a vector of data to the FIFO. Either all or none of the data
+ * will be written. This function may be called by multiple producers that
+ * preempt each other, such as interrupts of different priorities, without
+ * disabling interrupts. Space is reserved using an atomic compare-and-swap and
+ * the write index is only updated by the outermost producer, once all reserved
+ * data has been written. This function must only be used if all data in the
+ * FIFO is written using FifoWritevMultiProducer or FifoWriteMultiProducer.
+ * @param fifo FIFO structure.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoWritevMultiProducer(Fifo * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+    __sync_fetch_and_add(&fifo->writesInProgress, 1);
+
+    // Reserve space
+    const size_t numberOfBytes = FifoVectorsSize(vectors, numberOfVectors);
+    FifoResult result = FifoResultOk;
+    size_t reserveIndex;
+    size_t nextReserveIndex;
+    do {
+        reserveIndex = fifo->reserveIndex;
+        if (numberOfBytes > FifoAvailableWriteMultiProducer(fifo)) {
+            result = FifoResultError;
+            break;
+        }
+        nextReserveIndex = reserveIndex + numberOfBytes;
+        if (nextReserveIndex >= fifo->dataSize) {
+            nextReserveIndex -= fifo->dataSize;
+        }
+    } while (__sync_bool_compare_and_swap(&fifo->reserveIndex, reserveIndex, nextReserveIndex) == false);
+
+    // Write data
+    if (result == FifoResultOk) {
+        for (size_t index = 0; index < numberOfVectors; index++) {
+            reserveIndex = FifoWriteInternal(fifo, vectors[index].data, vectors[index].numberOfBytes, reserveIndex);
+        }
+    }
+
+    // Do not update write index if preempting another producer
+    if (__sync_sub_and_fetch(&fifo->writesInProgress, 1) != 0) {
+        return result;
+    }
+
+    // Update write index to include data written by all preempting producers
+    size_t writeIndex;
+    do {
+        writeIndex = fifo->writeIndex; // must be read before reserve index
+        reserveIndex = fifo->reserveIndex;
+        if (writeIndex == reserveIndex) {
+            break;
+        }
+    } while (__sync_bool_compare_and_swap(&fifo->writeIndex, writeIndex, reserveIndex) == false);
+    return result;
+}
+
+/**
+ * @brief Writes data to the FIFO. See FifoWritevMultiProducer.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoWriteMultiProducer(Fifo * const fifo, const void* const data, const size_t numberOfBytes) {
+    const FifoVector vector = {.data = data, .numberOfBytes = numberOfBytes};
+    return FifoWritevMultiProducer(fifo, &vector, 1);
+}
+
 /**
  * @brief Clears the FIFO.
  * @param fifo FIFO structure.
@@ -339,6 +823,733 @@ static inline __attribute__((always_inline)) void FifoClear(Fifo * const fifo) {
     fifo->readIndex = fifo->writeIndex;
 }
 
+/**
+ * @brief Returns the capacity of the FIFO.
+ * @param fifo FIFO structure.
+ * @return Capacity of the FIFO.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2Capacity(FifoPow2 * const fifo) {
+    return fifo->dataSize;
+}
+
+/**
+ * @brief Returns the number of bytes available to read from the FIFO.
+ * @param fifo FIFO structure.
+ * @return Number of bytes available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2AvailableRead(FifoPow2 * const fifo) {
+    return fifo->writeIndex - fifo->readIndex; // unsigned arithmetic handles index overflow
+}
+
+/**
+ * @brief Reads data from the FIFO.
+ * @param fifo FIFO structure.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2Read(FifoPow2 * const fifo, void* const destination, size_t numberOfBytes) {
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = FifoPow2AvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Read data
+    const size_t readIndex = fifo->readIndex & (fifo->dataSize - 1);
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    if (numberOfBytes <= numberOfBytesBeforeWraparound) {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytes);
+    } else {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytesBeforeWraparound);
+        memcpy(&((uint8_t*) destination)[numberOfBytesBeforeWraparound], (void*) fifo->data, numberOfBytes - numberOfBytesBeforeWraparound);
+    }
+    fifo->readIndex += numberOfBytes;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Reads a byte from the FIFO. This function must only be called if
+ * there are bytes available to read.
+ * @param fifo FIFO structure.
+ * @return Byte.
+ */
+static inline __attribute__((always_inline)) uint8_t FifoPow2ReadByte(FifoPow2 * const fifo) {
+    const size_t readIndex = fifo->readIndex;
+    const uint8_t byte = fifo->data[readIndex & (fifo->dataSize - 1)];
+    fifo->readIndex = readIndex + 1;
+    return byte;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the FIFO.
+ * FifoPow2ReadPointerComplete must be called after data has been read.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoPow2ReadPointer(FifoPow2 * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t readIndex = fifo->readIndex & (fifo->dataSize - 1);
+    *pointer = (void*) &fifo->data[readIndex];
+    const size_t bytesAvailable = FifoPow2AvailableRead(fifo);
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    *numberOfBytes = bytesAvailable < numberOfBytesBeforeWraparound ? bytesAvailable : numberOfBytesBeforeWraparound;
+}
+
+/**
+ * @brief Updates the FIFO after FifoPow2ReadPointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoPow2ReadPointerComplete(FifoPow2 * const fifo, const size_t numberOfBytes) {
+    fifo->readIndex += numberOfBytes;
+}
+
+/**
+ * @brief Reads data from the FIFO without removing it from the FIFO.
+ * @param fifo FIFO structure.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2Peek(FifoPow2 * const fifo, void* const destination, size_t numberOfBytes) {
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = FifoPow2AvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Read data
+    const size_t readIndex = fifo->readIndex & (fifo->dataSize - 1);
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    if (numberOfBytes <= numberOfBytesBeforeWraparound) {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytes);
+    } else {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytesBeforeWraparound);
+        memcpy(&((uint8_t*) destination)[numberOfBytesBeforeWraparound], (void*) fifo->data, numberOfBytes - numberOfBytesBeforeWraparound);
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Removes data from the FIFO without reading it.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes removed.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2Skip(FifoPow2 * const fifo, size_t numberOfBytes) {
+    const size_t bytesAvailable = FifoPow2AvailableRead(fifo);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+    fifo->readIndex += numberOfBytes;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the FIFO. The data is not
+ * removed from the FIFO.
+ * @param fifo FIFO structure.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result. FifoResultError if the byte was not found.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoPow2Find(FifoPow2 * const fifo, const uint8_t byte, size_t * const offset) {
+    const size_t bytesAvailable = FifoPow2AvailableRead(fifo);
+    const size_t readIndex = fifo->readIndex & (fifo->dataSize - 1);
+
+    // Search data before wraparound
+    size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    if (numberOfBytesBeforeWraparound > bytesAvailable) {
+        numberOfBytesBeforeWraparound = bytesAvailable;
+    }
+    *offset = FifoFindInternal((uint8_t*) &fifo->data[readIndex], numberOfBytesBeforeWraparound, byte);
+    if (*offset < numberOfBytesBeforeWraparound) {
+        return FifoResultOk;
+    }
+
+    // Search data after wraparound
+    const size_t numberOfBytesAfterWraparound = bytesAvailable - numberOfBytesBeforeWraparound;
+    const size_t index = FifoFindInternal((uint8_t*) fifo->data, numberOfBytesAfterWraparound, byte);
+    if (index == numberOfBytesAfterWraparound) {
+        return FifoResultError;
+    }
+    *offset = numberOfBytesBeforeWraparound + index;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Returns the space available to write to the FIFO.
+ * @param fifo FIFO structure.
+ * @return Space available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2AvailableWrite(FifoPow2 * const fifo) {
+    return fifo->dataSize - (fifo->writeIndex - fifo->readIndex); // unsigned arithmetic handles index overflow
+}
+
+/**
+ * @brief Writes data to the FIFO. This function is private.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param writeIndex Write index.
+ * @return Write index.
+ */
+static inline __attribute__((always_inline)) size_t FifoPow2WriteInternal(FifoPow2 * const fifo, const void* const data, const size_t numberOfBytes, const size_t writeIndex) {
+    const size_t maskedWriteIndex = writeIndex & (fifo->dataSize - 1);
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - maskedWriteIndex;
+    if (numberOfBytes <= numberOfBytesBeforeWraparound) {
+        memcpy((void*) &fifo->data[maskedWriteIndex], data, numberOfBytes);
+    } else {
+        memcpy((void*) &fifo->data[maskedWriteIndex], data, numberOfBytesBeforeWraparound);
+        memcpy((void*) fifo->data, &((uint8_t*) data)[numberOfBytesBeforeWraparound], numberOfBytes - numberOfBytesBeforeWraparound);
+    }
+    return writeIndex + numberOfBytes;
+}
+
+/**
+ * @brief Writes data to the FIFO.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoPow2Write(FifoPow2 * const fifo, const void* const data, const size_t numberOfBytes) {
+
+    // Do nothing if not enough space available
+    if (numberOfBytes > FifoPow2AvailableWrite(fifo)) {
+        return FifoResultError;
+    }
+
+    // Write data
+    fifo->writeIndex = FifoPow2WriteInternal(fifo, data, numberOfBytes, fifo->writeIndex);
+    return FifoResultOk;
+}
+
+/**
+ * @brief Writes a vector of data to the FIFO. Either all or none of the data
+ * will be written.
+ * @param fifo FIFO structure.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoPow2Writev(FifoPow2 * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+
+    // Do nothing if not enough space available
+    if (FifoVectorsSize(vectors, numberOfVectors) > FifoPow2AvailableWrite(fifo)) {
+        return FifoResultError;
+    }
+
+    // Write data
+    size_t writeIndex = fifo->writeIndex;
+    for (size_t index = 0; index < numberOfVectors; index++) {
+        writeIndex = FifoPow2WriteInternal(fifo, vectors[index].data, vectors[index].numberOfBytes, writeIndex);
+    }
+    fifo->writeIndex = writeIndex;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Writes a byte to the FIFO.
+ * @param fifo FIFO structure.
+ * @param byte Byte.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoPow2WriteByte(FifoPow2 * const fifo, const uint8_t byte) {
+
+    // Do nothing if not enough space available
+    if (FifoPow2AvailableWrite(fifo) == 0) {
+        return FifoResultError;
+    }
+
+    // Write byte
+    const size_t writeIndex = fifo->writeIndex;
+    fifo->data[writeIndex & (fifo->dataSize - 1)] = byte;
+    fifo->writeIndex = writeIndex + 1;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of space in the FIFO.
+ * FifoPow2WritePointerComplete must be called after data has been written.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoPow2WritePointer(FifoPow2 * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t writeIndex = fifo->writeIndex & (fifo->dataSize - 1);
+    *pointer = (void*) &fifo->data[writeIndex];
+    const size_t spaceAvailable = FifoPow2AvailableWrite(fifo);
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - writeIndex;
+    *numberOfBytes = spaceAvailable < numberOfBytesBeforeWraparound ? spaceAvailable : numberOfBytesBeforeWraparound;
+}
+
+/**
+ * @brief Updates the FIFO after FifoPow2WritePointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoPow2WritePointerComplete(FifoPow2 * const fifo, const size_t numberOfBytes) {
+    fifo->writeIndex += numberOfBytes;
+}
+
+/**
+ * @brief Clears the FIFO.
+ * @param fifo FIFO structure.
+ */
+static inline __attribute__((always_inline)) void FifoPow2Clear(FifoPow2 * const fifo) {
+    fifo->readIndex = fifo->writeIndex;
+}
+
+/**
+ * @brief Returns the capacity of the FIFO.
+ * @param fifo FIFO structure.
+ * @return Capacity of the FIFO.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastCapacity(FifoBroadcast * const fifo) {
+    return fifo->dataSize - 1;
+}
+
+/**
+ * @brief Resynchronises a reader with the writer if the reader was dropped.
+ * This function is private.
+ * @param fifo FIFO structure.
+ * @param reader Reader.
+ */
+static inline __attribute__((always_inline)) void FifoBroadcastResynchronise(FifoBroadcast * const fifo, FifoBroadcastReader * const reader) {
+    const uint32_t dropCount = reader->dropCount; // avoid asynchronous hazard
+    if (dropCount == reader->dropCountAcknowledged) {
+        return;
+    }
+    reader->readIndex = fifo->writeIndex; // read index must be updated before drop is acknowledged
+    reader->dropCountAcknowledged = dropCount;
+    reader->numberOfDrops++;
+}
+
+/**
+ * @brief Returns the number of bytes available to read from the FIFO. This
+ * function is private.
+ * @param fifo FIFO structure.
+ * @param readIndex Read index.
+ * @return Number of bytes available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastAvailableReadInternal(FifoBroadcast * const fifo, const size_t readIndex) {
+    const size_t writeIndex = fifo->writeIndex; // avoid asynchronous hazard
+    if (writeIndex < readIndex) {
+        return fifo->dataSize - readIndex + writeIndex;
+    } else {
+        return writeIndex - readIndex;
+    }
+}
+
+/**
+ * @brief Returns the number of bytes available to read from the FIFO.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ * @return Number of bytes available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastAvailableRead(FifoBroadcast * const fifo, const size_t readerIndex) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+    FifoBroadcastResynchronise(fifo, reader);
+    return FifoBroadcastAvailableReadInternal(fifo, reader->readIndex);
+}
+
+/**
+ * @brief Reads data from the FIFO.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read. 0 if the reader was dropped during the read.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastRead(FifoBroadcast * const fifo, const size_t readerIndex, void* const destination, size_t numberOfBytes) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+
+    // Limit number of bytes to number available
+    const size_t bytesAvailable = FifoBroadcastAvailableRead(fifo, readerIndex);
+    if (numberOfBytes > bytesAvailable) {
+        numberOfBytes = bytesAvailable;
+    }
+
+    // Read data
+    const size_t readIndex = reader->readIndex;
+    const size_t numberOfBytesBeforeWraparound = fifo->dataSize - readIndex;
+    size_t nextReadIndex;
+    if (numberOfBytes < numberOfBytesBeforeWraparound) {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytes);
+        nextReadIndex = readIndex + numberOfBytes;
+    } else {
+        memcpy(destination, (void*) &fifo->data[readIndex], numberOfBytesBeforeWraparound);
+        nextReadIndex = numberOfBytes - numberOfBytesBeforeWraparound;
+        memcpy(&((uint8_t*) destination)[numberOfBytesBeforeWraparound], (void*) fifo->data, nextReadIndex);
+    }
+
+    // Discard data if overwritten because reader was dropped
+    if (reader->dropCount != reader->dropCountAcknowledged) {
+        return 0;
+    }
+    reader->readIndex = nextReadIndex;
+    return numberOfBytes;
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the FIFO.
+ * FifoBroadcastReadPointerComplete must be called after data has been read.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoBroadcastReadPointer(FifoBroadcast * const fifo, const size_t readerIndex, volatile void* * const pointer, size_t * const numberOfBytes) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+    FifoBroadcastResynchronise(fifo, reader);
+    const size_t readIndex = reader->readIndex;
+    *pointer = (void*) &fifo->data[readIndex];
+    const size_t writeIndex = fifo->writeIndex; // avoid asynchronous hazard
+    if (writeIndex < readIndex) {
+        *numberOfBytes = fifo->dataSize - readIndex;
+    } else {
+        *numberOfBytes = writeIndex - readIndex;
+    }
+}
+
+/**
+ * @brief Updates the FIFO after FifoBroadcastReadPointer.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ * @param numberOfBytes Number of bytes.
+ * @return Result. FifoResultError if the reader was dropped and so the data may
+ * have been overwritten.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBroadcastReadPointerComplete(FifoBroadcast * const fifo, const size_t readerIndex, const size_t numberOfBytes) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+    if (reader->dropCount != reader->dropCountAcknowledged) {
+        return FifoResultError;
+    }
+    size_t readIndex = reader->readIndex + numberOfBytes;
+    if (readIndex >= fifo->dataSize) {
+        readIndex = 0;
+    }
+    reader->readIndex = readIndex;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Returns the number of times that the reader was dropped. Calling this
+ * function will reset the value.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ * @return Number of times that the reader was dropped.
+ */
+static inline __attribute__((always_inline)) uint32_t FifoBroadcastNumberOfDrops(FifoBroadcast * const fifo, const size_t readerIndex) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+    FifoBroadcastResynchronise(fifo, reader);
+    const uint32_t numberOfDrops = reader->numberOfDrops;
+    reader->numberOfDrops = 0;
+    return numberOfDrops;
+}
+
+/**
+ * @brief Returns the space available to write for a reader. This function is
+ * private.
+ * @param fifo FIFO structure.
+ * @param reader Reader.
+ * @return Space available in the buffer. SIZE_MAX if the reader is dropped.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastAvailableWriteInternal(FifoBroadcast * const fifo, FifoBroadcastReader * const reader) {
+    if (reader->dropCount != reader->dropCountAcknowledged) {
+        return SIZE_MAX; // dropped readers do not limit the space available
+    }
+    return FifoBroadcastCapacity(fifo) - FifoBroadcastAvailableReadInternal(fifo, reader->readIndex);
+}
+
+/**
+ * @brief Returns the space available to write to the FIFO. This is limited by
+ * the slowest reader.
+ * @param fifo FIFO structure.
+ * @return Space available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoBroadcastAvailableWrite(FifoBroadcast * const fifo) {
+    size_t available = FifoBroadcastCapacity(fifo);
+    for (size_t index = 0; index < fifo->numberOfReaders; index++) {
+        const size_t readerAvailable = FifoBroadcastAvailableWriteInternal(fifo, &fifo->readers[index]);
+        if (readerAvailable < available) {
+            available = readerAvailable;
+        }
+    }
+    return available;
+}
+
+/**
+ * @brief Writes a vector of data to the FIFO. Either all or none of the data
+ * will be written. If dropSlowReaders is true then any reader that would
+ * prevent the write is dropped.
+ * @param fifo FIFO structure.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBroadcastWritev(FifoBroadcast * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+
+    // Do nothing if not enough space available
+    const size_t numberOfBytes = FifoVectorsSize(vectors, numberOfVectors);
+    if (numberOfBytes > FifoBroadcastAvailableWrite(fifo)) {
+        if ((fifo->dropSlowReaders == false) || (numberOfBytes > FifoBroadcastCapacity(fifo))) {
+            return FifoResultError;
+        }
+
+        // Drop slow readers
+        for (size_t index = 0; index < fifo->numberOfReaders; index++) {
+            FifoBroadcastReader * const reader = &fifo->readers[index];
+            if (numberOfBytes > FifoBroadcastAvailableWriteInternal(fifo, reader)) {
+                reader->dropCount++;
+            }
+        }
+    }
+
+    // Write data
+    size_t writeIndex = fifo->writeIndex;
+    for (size_t index = 0; index < numberOfVectors; index++) {
+        const void* const data = vectors[index].data;
+        const size_t vectorSize = vectors[index].numberOfBytes;
+        const size_t numberOfBytesBeforeWraparound = fifo->dataSize - writeIndex;
+        if (vectorSize < numberOfBytesBeforeWraparound) {
+            memcpy((void*) &fifo->data[writeIndex], data, vectorSize);
+            writeIndex += vectorSize;
+        } else {
+            memcpy((void*) &fifo->data[writeIndex], data, numberOfBytesBeforeWraparound);
+            writeIndex = vectorSize - numberOfBytesBeforeWraparound;
+            memcpy((void*) fifo->data, &((uint8_t*) data)[numberOfBytesBeforeWraparound], writeIndex);
+        }
+    }
+    fifo->writeIndex = writeIndex;
+    return FifoResultOk;
+}
+
+/**
+ * @brief Writes data to the FIFO. See FifoBroadcastWritev.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBroadcastWrite(FifoBroadcast * const fifo, const void* const data, const size_t numberOfBytes) {
+    const FifoVector vector = {.data = data, .numberOfBytes = numberOfBytes};
+    return FifoBroadcastWritev(fifo, &vector, 1);
+}
+
+/**
+ * @brief Clears the FIFO for a reader.
+ * @param fifo FIFO structure.
+ * @param readerIndex Reader index.
+ */
+static inline __attribute__((always_inline)) void FifoBroadcastClear(FifoBroadcast * const fifo, const size_t readerIndex) {
+    FifoBroadcastReader * const reader = &fifo->readers[readerIndex];
+    FifoBroadcastResynchronise(fifo, reader);
+    reader->readIndex = fifo->writeIndex;
+}
+
+/**
+ * @brief Returns the number of bytes available to read from the FIFO.
+ * @param fifo FIFO structure.
+ * @return Number of bytes available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoBipAvailableRead(FifoBip * const fifo) {
+    const size_t writeIndex = fifo->writeIndex; // avoid asynchronous hazard
+    const size_t readIndex = fifo->readIndex;
+    if (writeIndex < readIndex) {
+        return fifo->endIndex - readIndex + writeIndex;
+    } else {
+        return writeIndex - readIndex;
+    }
+}
+
+/**
+ * @brief Provides a pointer to the next contiguous block of data in the FIFO.
+ * FifoBipReadPointerComplete must be called after data has been read.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoBipReadPointer(FifoBip * const fifo, volatile void* * const pointer, size_t * const numberOfBytes) {
+    const size_t writeIndex = fifo->writeIndex; // avoid asynchronous hazard
+    size_t readIndex = fifo->readIndex;
+    if (writeIndex < readIndex) {
+        const size_t endIndex = fifo->endIndex; // must be read after write index
+        if (readIndex == endIndex) {
+            readIndex = 0; // skip unused space at end
+            fifo->readIndex = readIndex;
+        } else {
+            *pointer = (void*) &fifo->data[readIndex];
+            *numberOfBytes = endIndex - readIndex;
+            return;
+        }
+    }
+    *pointer = (void*) &fifo->data[readIndex];
+    *numberOfBytes = writeIndex - readIndex;
+}
+
+/**
+ * @brief Updates the FIFO after FifoBipReadPointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void FifoBipReadPointerComplete(FifoBip * const fifo, const size_t numberOfBytes) {
+    fifo->readIndex += numberOfBytes;
+}
+
+/**
+ * @brief Reads data from the FIFO.
+ * @param fifo FIFO structure.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+static inline __attribute__((always_inline)) size_t FifoBipRead(FifoBip * const fifo, void* const destination, const size_t numberOfBytes) {
+    size_t numberOfBytesRead = 0;
+    for (int block = 0; block < 2; block++) { // data may be split across end and start of buffer
+        volatile void* pointer;
+        size_t blockSize;
+        FifoBipReadPointer(fifo, &pointer, &blockSize);
+        if (blockSize > (numberOfBytes - numberOfBytesRead)) {
+            blockSize = numberOfBytes - numberOfBytesRead;
+        }
+        memcpy(&((uint8_t*) destination)[numberOfBytesRead], (void*) pointer, blockSize);
+        FifoBipReadPointerComplete(fifo, blockSize);
+        numberOfBytesRead += blockSize;
+    }
+    return numberOfBytesRead;
+}
+
+/**
+ * @brief Returns the size of the largest contiguous block that can be written
+ * to the FIFO.
+ * @param fifo FIFO structure.
+ * @return Space available in the buffer.
+ */
+static inline __attribute__((always_inline)) size_t FifoBipAvailableWrite(FifoBip * const fifo) {
+    const size_t readIndex = fifo->readIndex; // avoid asynchronous hazard
+    const size_t writeIndex = fifo->writeIndex;
+    if (writeIndex < readIndex) {
+        return readIndex - writeIndex - 1; // write index must not reach read index
+    }
+    const size_t spaceAtEnd = fifo->dataSize - writeIndex;
+    const size_t spaceAtStart = readIndex == 0 ? 0 : readIndex - 1;
+    return spaceAtEnd > spaceAtStart ? spaceAtEnd : spaceAtStart;
+}
+
+/**
+ * @brief Provides a pointer to a contiguous block of space in the FIFO.
+ * FifoBipWritePointerComplete must be called after data has been written.
+ * @param fifo FIFO structure.
+ * @param pointer Pointer.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBipWritePointer(FifoBip * const fifo, volatile void* * const pointer, const size_t numberOfBytes) {
+    const size_t readIndex = fifo->readIndex; // avoid asynchronous hazard
+    const size_t writeIndex = fifo->writeIndex;
+    if (writeIndex < readIndex) {
+        if ((writeIndex + numberOfBytes) >= readIndex) {
+            return FifoResultError;
+        }
+        fifo->reserveIndex = writeIndex;
+    } else if ((fifo->dataSize - writeIndex) >= numberOfBytes) {
+        fifo->reserveIndex = writeIndex;
+    } else if (numberOfBytes < readIndex) {
+        fifo->reserveIndex = 0; // write to start of buffer
+    } else {
+        return FifoResultError;
+    }
+    *pointer = (void*) &fifo->data[fifo->reserveIndex];
+    return FifoResultOk;
+}
+
+/**
+ * @brief Updates the FIFO after FifoBipWritePointer.
+ * @param fifo FIFO structure.
+ * @param numberOfBytes Number of bytes. Must not be greater than the number
+ * of bytes provided by FifoBipWritePointer.
+ */
+static inline __attribute__((always_inline)) void FifoBipWritePointerComplete(FifoBip * const fifo, const size_t numberOfBytes) {
+    const size_t writeIndex = fifo->writeIndex;
+    const size_t nextWriteIndex = fifo->reserveIndex + numberOfBytes;
+    if ((nextWriteIndex < writeIndex) && (writeIndex != fifo->dataSize)) {
+        fifo->endIndex = writeIndex; // end index must be updated before write index
+    } else if (nextWriteIndex > fifo->endIndex) {
+        fifo->endIndex = fifo->dataSize;
+    }
+    fifo->writeIndex = nextWriteIndex;
+}
+
+/**
+ * @brief Writes a vector of data to the FIFO as a contiguous block. Either all
+ * or none of the data will be written.
+ * @param fifo FIFO structure.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBipWritev(FifoBip * const fifo, const FifoVector * const vectors, const size_t numberOfVectors) {
+    const size_t numberOfBytes = FifoVectorsSize(vectors, numberOfVectors);
+    volatile void* pointer;
+    if (FifoBipWritePointer(fifo, &pointer, numberOfBytes) != FifoResultOk) {
+        return FifoResultError;
+    }
+    volatile uint8_t * const destination = pointer;
+    size_t index = 0;
+    for (size_t vectorIndex = 0; vectorIndex < numberOfVectors; vectorIndex++) {
+        memcpy((void*) &destination[index], vectors[vectorIndex].data, vectors[vectorIndex].numberOfBytes);
+        index += vectors[vectorIndex].numberOfBytes;
+    }
+    FifoBipWritePointerComplete(fifo, numberOfBytes);
+    return FifoResultOk;
+}
+
+/**
+ * @brief Writes data to the FIFO as a contiguous block.
+ * @param fifo FIFO structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBipWrite(FifoBip * const fifo, const void* const data, const size_t numberOfBytes) {
+    volatile void* pointer;
+    if (FifoBipWritePointer(fifo, &pointer, numberOfBytes) != FifoResultOk) {
+        return FifoResultError;
+    }
+    memcpy((void*) pointer, data, numberOfBytes);
+    FifoBipWritePointerComplete(fifo, numberOfBytes);
+    return FifoResultOk;
+}
+
+/**
+ * @brief Writes a byte to the FIFO.
+ * @param fifo FIFO structure.
+ * @param byte Byte.
+ * @return Result.
+ */
+static inline __attribute__((always_inline)) FifoResult FifoBipWriteByte(FifoBip * const fifo, const uint8_t byte) {
+    volatile void* pointer;
+    if (FifoBipWritePointer(fifo, &pointer, 1) != FifoResultOk) {
+        return FifoResultError;
+    }
+    *(volatile uint8_t*) pointer = byte;
+    FifoBipWritePointerComplete(fifo, 1);
+    return FifoResultOk;
+}
+
+/**
+ * @brief Clears the FIFO.
+ * @param fifo FIFO structure.
+ */
+static inline __attribute__((always_inline)) void FifoBipClear(FifoBip * const fifo) {
+    fifo->readIndex = fifo->writeIndex;
+}
+
 #endif
 
 //------------------------------------------------------------------------------
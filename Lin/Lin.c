@@ -0,0 +1,223 @@
+/**
+ * @file Lin.c
+ * @author Seb Madgwick
+ * @brief Local Interconnect Network (LIN) master scheduler. Each frame header
+ * and published response is written to a UART DMA driver as a single write so
+ * that the CPU is not blocked while the frame is transmitted.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Lin.h"
+#include <string.h>
+#include "Timer/Timer.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Break read back as a zero byte with a framing error.
+ */
+#define BREAK (0x00)
+
+/**
+ * @brief Sync byte.
+ */
+#define SYNC (0x55)
+
+/**
+ * @brief Nominal header length in bits. Break (13), break delimiter (1), sync
+ * (10) and protected identifier (10).
+ */
+#define HEADER_BITS (34)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void StartFrame(LinMaster * const lin, const uint64_t ticks);
+static LinResult FrameResult(LinMaster * const lin);
+static void FrameComplete(LinMaster * const lin, const LinResult result);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Starts the schedule from the first frame. The master is not started
+ * if the schedule is empty, the baud rate is zero or a frame has an invalid
+ * number of bytes.
+ * @param lin Master structure.
+ * @return True if the master was started.
+ */
+bool LinMasterStart(LinMaster * const lin) {
+    lin->started = false;
+    if ((lin->schedule == NULL) || (lin->scheduleLength == 0) || (lin->baudRate == 0)) {
+        return false;
+    }
+    for (size_t index = 0; index < lin->scheduleLength; index++) {
+        const uint8_t numberOfBytes = lin->schedule[index].numberOfBytes;
+        if ((numberOfBytes == 0) || (numberOfBytes > LIN_MAX_NUMBER_OF_BYTES)) {
+            return false;
+        }
+    }
+    lin->index = 0;
+    lin->slotTicks = TimerGetTicks64();
+    lin->inProgress = false;
+    lin->started = true;
+    return true;
+}
+
+/**
+ * @brief Master tasks. This function should be called repeatedly within the
+ * main program loop.
+ * @param lin Master structure.
+ */
+void LinMasterTasks(LinMaster * const lin) {
+    if (lin->started == false) {
+        return;
+    }
+    const uint64_t ticks = TimerGetTicks64();
+
+    // Read back header and response until complete or timeout
+    if (lin->inProgress) {
+        const LinFrame * const frame = &lin->schedule[lin->index];
+        const size_t frameSize = 3 + frame->numberOfBytes + 1;
+        lin->bufferIndex += lin->read(&lin->buffer[lin->bufferIndex], frameSize - lin->bufferIndex);
+        if ((lin->bufferIndex < frameSize) && (ticks < lin->timeoutTicks)) {
+            return;
+        }
+        FrameComplete(lin, FrameResult(lin));
+    }
+
+    // Start next frame at start of slot
+    if (ticks < lin->slotTicks) {
+        return;
+    }
+    StartFrame(lin, ticks);
+}
+
+/**
+ * @brief Writes the header and published response of the current frame.
+ * @param lin Master structure.
+ * @param ticks Ticks.
+ */
+static void StartFrame(LinMaster * const lin, const uint64_t ticks) {
+    const LinFrame * const frame = &lin->schedule[lin->index];
+
+    // Schedule next slot
+    lin->slotTicks += (uint64_t) frame->slot * TIMER_TICKS_PER_MILLISECOND;
+    if (lin->slotTicks < ticks) {
+        lin->slotTicks = ticks; // avoid burst of frames if behind schedule
+    }
+
+    // Discard data received outside of frame
+    uint8_t discard[16];
+    while (lin->read(discard, sizeof (discard)) > 0) {
+    }
+
+    // Create header and published response
+    const uint8_t protectedIdentifier = LinProtectedIdentifier(frame->id);
+    uint8_t data[2 + LIN_MAX_NUMBER_OF_BYTES + 1];
+    data[0] = SYNC;
+    data[1] = protectedIdentifier;
+    size_t numberOfBytes = 2;
+    if (frame->direction == LinDirectionPublish) {
+        memcpy(&data[numberOfBytes], frame->data, frame->numberOfBytes);
+        numberOfBytes += frame->numberOfBytes;
+        data[numberOfBytes++] = LinCalculateChecksum(frame->checksum, protectedIdentifier, frame->data, frame->numberOfBytes);
+    }
+
+    // Write break, header and published response
+    if (lin->writeBreak() != FifoResultOk) {
+        FrameComplete(lin, LinResultHeaderError);
+        return;
+    }
+    if (lin->write(data, numberOfBytes) != FifoResultOk) {
+        FrameComplete(lin, LinResultHeaderError);
+        return;
+    }
+
+    // Start read back with maximum frame time of 1.4 times nominal
+    const uint32_t frameBits = HEADER_BITS + (10 * (frame->numberOfBytes + 1));
+    lin->timeoutTicks = ticks + (((uint64_t) 14 * frameBits * TIMER_TICKS_PER_SECOND) / ((uint64_t) 10 * lin->baudRate));
+    lin->bufferIndex = 0;
+    lin->inProgress = true;
+}
+
+/**
+ * @brief Returns the result of the current frame from the data read back.
+ * @param lin Master structure.
+ * @return Result.
+ */
+static LinResult FrameResult(LinMaster * const lin) {
+    LinFrame * const frame = &lin->schedule[lin->index];
+
+    // Check header
+    const uint8_t protectedIdentifier = LinProtectedIdentifier(frame->id);
+    if ((lin->bufferIndex < 3) || (lin->buffer[0] != BREAK) || (lin->buffer[1] != SYNC) || (lin->buffer[2] != protectedIdentifier)) {
+        return LinResultHeaderError;
+    }
+
+    // Check response
+    const size_t frameSize = 3 + frame->numberOfBytes + 1;
+    if (lin->bufferIndex < frameSize) {
+        return LinResultTimeout;
+    }
+    const uint8_t * const response = &lin->buffer[3];
+    if (response[frame->numberOfBytes] != LinCalculateChecksum(frame->checksum, protectedIdentifier, response, frame->numberOfBytes)) {
+        return frame->direction == LinDirectionPublish ? LinResultBitError : LinResultChecksumError;
+    }
+
+    // Update subscribed data
+    if (frame->direction == LinDirectionSubscribe) {
+        memcpy(frame->data, response, frame->numberOfBytes);
+    }
+    return LinResultOk;
+}
+
+/**
+ * @brief Calls the frame callback and advances to the next frame in the
+ * schedule.
+ * @param lin Master structure.
+ * @param result Result.
+ */
+static void FrameComplete(LinMaster * const lin, const LinResult result) {
+    if (lin->frame != NULL) {
+        lin->frame(&lin->schedule[lin->index], result);
+    }
+    lin->index = (lin->index + 1) % lin->scheduleLength;
+    lin->inProgress = false;
+}
+
+/**
+ * @brief Returns the protected identifier of a frame identifier.
+ * @param id Frame identifier.
+ * @return Protected identifier.
+ */
+uint8_t LinProtectedIdentifier(const uint8_t id) {
+    const uint8_t p0 = ((id >> 0) ^ (id >> 1) ^ (id >> 2) ^ (id >> 4)) & 1;
+    const uint8_t p1 = (~((id >> 1) ^ (id >> 3) ^ (id >> 4) ^ (id >> 5))) & 1;
+    return (id & 0x3F) | (p0 << 6) | (p1 << 7);
+}
+
+/**
+ * @brief Calculates the checksum of a response.
+ * @param checksum Checksum model.
+ * @param protectedIdentifier Protected identifier.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Checksum.
+ */
+uint8_t LinCalculateChecksum(const LinChecksum checksum, const uint8_t protectedIdentifier, const uint8_t * const data, const size_t numberOfBytes) {
+    uint32_t sum = (checksum == LinChecksumEnhanced) ? protectedIdentifier : 0;
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        sum += data[index];
+        if (sum > 0xFF) {
+            sum -= 0xFF; // sum with carry
+        }
+    }
+    return ~sum;
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,107 @@
+/**
+ * @file Lin.h
+ * @author Seb Madgwick
+ * @brief Local Interconnect Network (LIN) master scheduler. Each frame header
+ * and published response is written to a UART DMA driver as a single write so
+ * that the CPU is not blocked while the frame is transmitted.
+ */
+
+#ifndef LIN_H
+#define LIN_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum number of data bytes in a frame.
+ */
+#define LIN_MAX_NUMBER_OF_BYTES (8)
+
+/**
+ * @brief Frame direction.
+ */
+typedef enum {
+    LinDirectionPublish, // response transmitted by master
+    LinDirectionSubscribe, // response transmitted by slave
+} LinDirection;
+
+/**
+ * @brief Checksum model.
+ */
+typedef enum {
+    LinChecksumClassic, // data only, LIN 1.x and diagnostic frames
+    LinChecksumEnhanced, // protected identifier and data, LIN 2.x
+} LinChecksum;
+
+/**
+ * @brief Frame result.
+ */
+typedef enum {
+    LinResultOk,
+    LinResultHeaderError, // break, sync or protected identifier not read back
+    LinResultBitError, // published response not read back
+    LinResultTimeout, // no response or incomplete response
+    LinResultChecksumError,
+} LinResult;
+
+/**
+ * @brief Schedule table entry. The data of a published frame may be modified
+ * by the user at any time. The data of a subscribed frame is updated each time
+ * a valid response is received.
+ */
+typedef struct {
+    uint8_t id; // 0 to 63
+    LinDirection direction;
+    LinChecksum checksum;
+    uint8_t numberOfBytes; // 1 to LIN_MAX_NUMBER_OF_BYTES
+    uint8_t data[LIN_MAX_NUMBER_OF_BYTES];
+    uint32_t slot; // milliseconds until next frame
+} LinFrame;
+
+/**
+ * @brief Master structure. The UART functions, schedule and baud rate must be
+ * initialised by the user. The UART must receive its own transmissions, as is
+ * the case for a LIN transceiver. The frame callback is called once per frame
+ * with the result. NULL if unused. The read function must be that of the UART
+ * interrupt driver or a UART DMA driver using the stream read mode. The read
+ * function of the block, ping-pong and deferred read modes always returns 0
+ * because received data is passed to the read callback. All other structure
+ * members are private.
+ */
+typedef struct {
+    FifoResult (*const writeBreak) (void);
+    FifoResult (*const write) (const void* const data, const size_t numberOfBytes);
+    size_t (*const read) (void* const destination, size_t numberOfBytes);
+    LinFrame * const schedule;
+    const size_t scheduleLength;
+    const uint32_t baudRate;
+    void (*const frame) (const LinFrame * const frame, const LinResult result);
+    bool started;
+    size_t index;
+    uint64_t slotTicks;
+    uint64_t timeoutTicks;
+    bool inProgress;
+    uint8_t buffer[3 + LIN_MAX_NUMBER_OF_BYTES + 1]; // break, sync, protected identifier, data and checksum
+    size_t bufferIndex;
+} LinMaster;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+bool LinMasterStart(LinMaster * const lin);
+void LinMasterTasks(LinMaster * const lin);
+uint8_t LinProtectedIdentifier(const uint8_t id);
+uint8_t LinCalculateChecksum(const LinChecksum checksum, const uint8_t protectedIdentifier, const uint8_t * const data, const size_t numberOfBytes);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
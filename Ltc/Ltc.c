@@ -112,7 +112,12 @@ typedef enum {
 typedef struct {
     uint64_t ticks;
     FrameData data;
-} __attribute__((__packed__)) FifoPacket;
+} FifoPacket;
+
+/**
+ * @brief FIFO of packets.
+ */
+FIFO_TYPED(PacketFifo, FifoPacket, 128)
 
 //------------------------------------------------------------------------------
 // Function declarations
@@ -135,18 +140,21 @@ static bool secondHalfBitPeriodPending;
 static volatile uint64_t holdoffTimeout;
 static volatile int decodeError; // __sync_lock_test_and_set cannot be used with bool
 static volatile uint64_t noSignalTimeout;
-static uint8_t fifoData[(128 * sizeof (FifoPacket)) + 1]; // FIFO capacity is 1 less than size
-static Fifo fifo = {.data = fifoData, .dataSize = sizeof (fifoData)};
+static PacketFifo fifo;
 static volatile uint32_t bufferOverflow;
+static bool bufferOverwrite;
 
 //------------------------------------------------------------------------------
 // Functions
 
 /**
  * @brief Initialises the module.
+ * @param bufferOverwrite_ True to discard the oldest frames if the buffer is
+ * full, otherwise the newest frames are discarded.
  */
-void LtcInitialise(void) {
+void LtcInitialise(const bool bufferOverwrite_) {
     LtcDeinitialise();
+    bufferOverwrite = bufferOverwrite_;
     LTC_INPUT_CAPTURE.initialise(&inputCaptureSettings, CaptureEvent);
     noSignalTimeout = TimerGetTicks64() + NO_SIGNAL_TIMEOUT;
 }
@@ -160,7 +168,7 @@ void LtcDeinitialise(void) {
     holdoffTimeout = 0;
     decodeError = 0;
     noSignalTimeout = 0;
-    FifoClear(&fifo);
+    PacketFifoClear(&fifo);
     bufferOverflow = 0;
 }
 
@@ -209,7 +217,9 @@ static void CaptureEvent(const uint64_t ticks) {
                 .ticks = ticks,
                 .data = frameBuffer.data,
             };
-            if (FifoWrite(&fifo, &fifoPacket, sizeof (fifoPacket)) != FifoResultOk) {
+            if (bufferOverwrite) {
+                bufferOverflow += PacketFifoWriteOverwrite(&fifo, &fifoPacket);
+            } else if (PacketFifoWrite(&fifo, &fifoPacket) != FifoResultOk) {
                 bufferOverflow++;
             }
             break;
@@ -414,7 +424,7 @@ bool LtcNoSignal(void) {
  */
 LtcResult LtcGetData(LtcData * const data) {
     FifoPacket fifoPacket;
-    if (FifoRead(&fifo, &fifoPacket, sizeof (fifoPacket)) == 0) {
+    if (PacketFifoRead(&fifo, &fifoPacket) != FifoResultOk) {
         return LtcResultError;
     }
     data->ticks = fifoPacket.ticks;
@@ -437,8 +447,10 @@ LtcResult LtcGetData(LtcData * const data) {
 }
 
 /**
- * @brief Returns the number of frames lost due to buffer overflow. Calling
- * this function will reset the value.
+ * @brief Returns the number of frames lost due to buffer overflow. The oldest
+ * frames are lost if buffer overwrite was selected at initialisation,
+ * otherwise the newest frames are lost. Calling this function will reset the
+ * value.
  * @return Number of frames lost due to buffer overflow.
  */
 uint32_t LtcBufferOverflow(void) {
@@ -40,7 +40,7 @@ typedef struct {
 //------------------------------------------------------------------------------
 // Function declarations
 
-void LtcInitialise(void);
+void LtcInitialise(const bool bufferOverwrite_);
 void LtcDeinitialise(void);
 void LtcTasks(void);
 bool LtcDecodeError(void);
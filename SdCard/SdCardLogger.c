@@ -483,17 +483,30 @@ const char* SdCardLoggerGetFileName(void) {
  * @return Space available in the write buffer.
  */
 size_t SdCardLoggerAvailableWrite(void) {
-    return FifoAvailableWrite(&fifo);
+    return FifoAvailableWriteMultiProducer(&fifo);
 }
 
 /**
- * @brief Writes data to the write buffer.
+ * @brief Writes data to the write buffer. This function may be called from
+ * multiple interrupts without disabling interrupts.
  * @param data Data.
  * @param numberOfBytes Number of bytes.
  * @return Result.
  */
 FifoResult SdCardLoggerWrite(const void* const data, const size_t numberOfBytes) {
-    return FifoWrite(&fifo, data, numberOfBytes);
+    return FifoWriteMultiProducer(&fifo, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written. This function may be called from multiple interrupts
+ * without disabling interrupts.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult SdCardLoggerWritev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return FifoWritevMultiProducer(&fifo, vectors, numberOfVectors);
 }
 
 /**
@@ -92,6 +92,7 @@ bool SdCardLoggerLogging(void);
 const char* SdCardLoggerGetFileName(void);
 size_t SdCardLoggerAvailableWrite(void);
 FifoResult SdCardLoggerWrite(const void* const data, const size_t numberOfBytes);
+FifoResult SdCardLoggerWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 const char* SdCardLoggerEventToString(const SdCardLoggerEvent event);
 const char* SdCardLoggerErrorToString(const SdCardLoggerError error);
 
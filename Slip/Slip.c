@@ -0,0 +1,217 @@
+/**
+ * @file Slip.c
+ * @author Seb Madgwick
+ * @brief Serial Line Internet Protocol (SLIP) framing. See RFC 1055. Frames are
+ * delimited by SLIP_END so that a UART DMA driver may use SLIP_END as the read
+ * termination byte and receive one frame per read callback.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Slip.h"
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Special characters.
+ */
+#define ESC (0xDB)
+#define ESC_END (0xDC)
+#define ESC_ESC (0xDD)
+
+/**
+ * @brief Number of vectors written to the write buffer per writev call.
+ */
+#define NUMBER_OF_VECTORS (16)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline __attribute__((always_inline)) bool IsSpecial(const uint8_t byte);
+static inline __attribute__((always_inline)) void Append(SlipDecoder * const decoder, const uint8_t byte);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static const uint8_t end = SLIP_END;
+static const uint8_t escapedEnd[] = {ESC, ESC_END};
+static const uint8_t escapedEsc[] = {ESC, ESC_ESC};
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Encodes a frame and writes it to a write buffer. The encoded frame is
+ * written as vectors of escape sequences and unmodified runs of the data so
+ * that no intermediate buffer is required. The frame is written using several
+ * writev calls so the write buffer must have no other writer. Either all or
+ * none of the frame will be written.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param availableWrite Available write function of the driver, e.g.
+ * Uart1DmaAvailableWrite or UsbCdcAvailableWrite.
+ * @param writev Writev function of the driver, e.g. Uart1DmaWritev or
+ * UsbCdcWritev.
+ * @return Result.
+ */
+FifoResult SlipWrite(const void* const data, const size_t numberOfBytes, size_t (*const availableWrite) (void), FifoResult (*const writev) (const FifoVector * const vectors, const size_t numberOfVectors)) {
+    const uint8_t * const bytes = data;
+
+    // Ensure space available for encoded frame
+    size_t encodedSize = numberOfBytes + 1;
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        if (IsSpecial(bytes[index])) {
+            encodedSize++;
+        }
+    }
+    if (availableWrite() < encodedSize) {
+        return FifoResultError;
+    }
+
+    // Write runs and escape sequences
+    FifoVector vectors[NUMBER_OF_VECTORS];
+    size_t numberOfVectors = 0;
+    size_t index = 0;
+    while (true) {
+
+        // Add run of bytes that do not require escaping
+        size_t length = 0;
+        while (((index + length) < numberOfBytes) && (IsSpecial(bytes[index + length]) == false)) {
+            length++;
+        }
+        if (length > 0) {
+            vectors[numberOfVectors++] = (FifoVector){.data = &bytes[index], .numberOfBytes = length};
+        }
+        index += length;
+
+        // Add escape sequence or end
+        const bool complete = index == numberOfBytes;
+        if (complete) {
+            vectors[numberOfVectors++] = (FifoVector){.data = &end, .numberOfBytes = 1};
+        } else {
+            vectors[numberOfVectors++] = (FifoVector){.data = bytes[index] == SLIP_END ? escapedEnd : escapedEsc, .numberOfBytes = 2};
+            index++;
+        }
+
+        // Write vectors
+        if (complete || (numberOfVectors > (NUMBER_OF_VECTORS - 2))) {
+            const FifoResult result = writev(vectors, numberOfVectors);
+            if ((result != FifoResultOk) || complete) {
+                return result;
+            }
+            numberOfVectors = 0;
+        }
+    }
+}
+
+/**
+ * @brief Returns true if the byte must be escaped.
+ * @param byte Byte.
+ * @return True if the byte must be escaped.
+ */
+static inline __attribute__((always_inline)) bool IsSpecial(const uint8_t byte) {
+    return (byte == SLIP_END) || (byte == ESC);
+}
+
+/**
+ * @brief Processes received data. The frame callback will be called for each
+ * valid frame.
+ * @param decoder Decoder structure.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+void SlipDecoderProcess(SlipDecoder * const decoder, const void* const data, const size_t numberOfBytes) {
+    const uint8_t * const bytes = data;
+    size_t index = 0;
+    while (index < numberOfBytes) {
+
+        // Copy run of bytes that do not require unescaping
+        size_t length = 0;
+        if (decoder->escape == false) {
+            const size_t space = decoder->dataSize - decoder->index;
+            while (((index + length) < numberOfBytes) && (length < space) && (IsSpecial(bytes[index + length]) == false)) {
+                length++;
+            }
+        }
+        memcpy(&decoder->data[decoder->index], &bytes[index], length);
+        decoder->index += length;
+        index += length;
+
+        // Process special or overflowing byte
+        if (index < numberOfBytes) {
+            SlipDecoderProcessByte(decoder, bytes[index++]);
+        }
+    }
+}
+
+/**
+ * @brief Processes a received byte. The frame callback will be called if the
+ * byte completes a valid frame.
+ * @param decoder Decoder structure.
+ * @param byte Byte.
+ */
+void SlipDecoderProcessByte(SlipDecoder * const decoder, const uint8_t byte) {
+
+    // End
+    if (byte == SLIP_END) {
+        if ((decoder->index > 0) && (decoder->escape == false) && (decoder->error == false)) {
+            decoder->frame(decoder->data, decoder->index);
+        }
+        SlipDecoderClear(decoder);
+        return;
+    }
+
+    // Escaped byte
+    if (decoder->escape) {
+        decoder->escape = false;
+        switch (byte) {
+            case ESC_END:
+                Append(decoder, SLIP_END);
+                return;
+            case ESC_ESC:
+                Append(decoder, ESC);
+                return;
+            default:
+                decoder->error = true; // invalid escape sequence
+                return;
+        }
+    }
+
+    // Escape
+    if (byte == ESC) {
+        decoder->escape = true;
+        return;
+    }
+
+    // Data byte
+    Append(decoder, byte);
+}
+
+/**
+ * @brief Appends a byte to the frame.
+ * @param decoder Decoder structure.
+ * @param byte Byte.
+ */
+static inline __attribute__((always_inline)) void Append(SlipDecoder * const decoder, const uint8_t byte) {
+    if (decoder->index >= decoder->dataSize) {
+        decoder->error = true;
+        return;
+    }
+    decoder->data[decoder->index++] = byte;
+}
+
+/**
+ * @brief Discards any partially received frame.
+ * @param decoder Decoder structure.
+ */
+void SlipDecoderClear(SlipDecoder * const decoder) {
+    decoder->index = 0;
+    decoder->escape = false;
+    decoder->error = false;
+}
+
+//------------------------------------------------------------------------------
+// End of file
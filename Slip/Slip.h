@@ -0,0 +1,58 @@
+/**
+ * @file Slip.h
+ * @author Seb Madgwick
+ * @brief Serial Line Internet Protocol (SLIP) framing. See RFC 1055. Frames are
+ * delimited by SLIP_END so that a UART DMA driver may use SLIP_END as the read
+ * termination byte and receive one frame per read callback. An encoded frame
+ * is written to the destination write buffer using several writev calls. The
+ * write buffer must therefore have exactly one writer. Frames may be
+ * interleaved with other data if the write buffer is shared, for example,
+ * with SdCardLoggerWritev or a second producer.
+ */
+
+#ifndef SLIP_H
+#define SLIP_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Frame delimiter.
+ */
+#define SLIP_END (0xC0)
+
+/**
+ * @brief Decoder structure. The data, data size and frame callback must be
+ * initialised by the user. The frame callback is called with the decoded
+ * frame each time a valid frame is received. Empty frames and frames larger
+ * than the data size are discarded. All other structure members are private.
+ */
+typedef struct {
+    uint8_t * const data;
+    const size_t dataSize;
+    void (*const frame) (const void* const data, const size_t numberOfBytes);
+    size_t index;
+    bool escape;
+    bool error;
+} SlipDecoder;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+FifoResult SlipWrite(const void* const data, const size_t numberOfBytes, size_t (*const availableWrite) (void), FifoResult (*const writev) (const FifoVector * const vectors, const size_t numberOfVectors));
+void SlipDecoderProcess(SlipDecoder * const decoder, const void* const data, const size_t numberOfBytes);
+void SlipDecoderProcessByte(SlipDecoder * const decoder, const uint8_t byte);
+void SlipDecoderClear(SlipDecoder * const decoder);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -9,6 +9,7 @@
 
 #include "Config.h"
 #include "definitions.h"
+#include "Dma/Dma.h"
 #include "Spi2DmaTx.h"
 #include <stdio.h>
 #include "sys/kmem.h"
@@ -21,6 +22,11 @@
  */
 //#define PRINT_TRANSFERS
 
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void TxDmaInterruptHandler(void);
+
 //------------------------------------------------------------------------------
 // Variables
 
@@ -29,6 +35,7 @@ const Spi spi2DmaTx = {
     .transferInProgress = Spi2DmaTxTransferInProgress,
 };
 
+static DmaChannel* txDma;
 static GPIO_PIN csPin;
 static void (*transferComplete)(void);
 
@@ -55,23 +62,27 @@ void Spi2DmaTxInitialise(const SpiSettings * const settings) {
     SPI2BRG = SpiCalculateSpixbrg(settings->clockFrequency);
     SPI2CONbits.ON = 1;
 
-    // Enable DMA
-    DMACONbits.ON = 1;
+    // Allocate DMA channel
+    txDma = DmaAllocate(TxDmaInterruptHandler);
+    if (txDma == NULL) {
+        Spi2DmaTxDeinitialise();
+        return;
+    }
 
     // Configure TX DMA channel
 #ifdef _SPI2_TX_IRQ
-    DCH0ECONbits.CHSIRQ = _SPI2_TX_IRQ; // channel transfer start IRQ
+    txDma->registers->DCHxECONbits.CHSIRQ = _SPI2_TX_IRQ; // channel transfer start IRQ
 #else
-    DCH0ECONbits.CHSIRQ = _SPI2_TX_VECTOR; // channel transfer start IRQ
+    txDma->registers->DCHxECONbits.CHSIRQ = _SPI2_TX_VECTOR; // channel transfer start IRQ
 #endif
-    DCH0ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH0DSA = KVA_TO_PA(&SPI2BUF); // destination address
-    DCH0DSIZ = 1; // destination size
-    DCH0CSIZ = 1; // transfers per event
-    DCH0INTbits.CHBCIE = 1; // channel Block Transfer Complete Interrupt Enable bit
+    txDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+    txDma->registers->DCHxDSA = KVA_TO_PA(&SPI2BUF); // destination address
+    txDma->registers->DCHxDSIZ = 1; // destination size
+    txDma->registers->DCHxCSIZ = 1; // transfers per event
+    txDma->registers->DCHxINTbits.CHBCIE = 1; // channel Block Transfer Complete Interrupt Enable bit
 
     // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_DMA0);
+    EVIC_SourceEnable(txDma->interruptSource);
 }
 
 /**
@@ -86,29 +97,17 @@ void Spi2DmaTxDeinitialise(void) {
     SPI2BRG = 0;
 
     // Disable TX DMA channel and restore default register states
-    DCH0CON = 0;
-    DCH0ECON = 0;
-    DCH0INT = 0;
-    DCH0SSA = 0;
-    DCH0DSA = 0;
-    DCH0SSIZ = 0;
-    DCH0DSIZ = 0;
-    DCH0SPTR = 0;
-    DCH0DPTR = 0;
-    DCH0CSIZ = 0;
-    DCH0CPTR = 0;
-    DCH0DAT = 0;
-
-    // Disable interrupt
-    EVIC_SourceDisable(INT_SOURCE_DMA0);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
+    DmaFree(txDma);
+    txDma = NULL;
 }
 
 /**
  * @brief Transfers data. Received data will be discarded. The data must be
  * declared __attribute__((coherent)) for PIC32MZ devices. This function must
  * not be called while a transfer is in progress. The transfer complete callback
- * will be called from within an interrupt once the transfer is complete.
+ * will be called from within an interrupt once the transfer is complete. The
+ * transfer complete callback will be called immediately and no data will be
+ * transmitted if the DMA channel was not allocated.
  * @param csPin_ CS pin.
  * @param data Data.
  * @param numberOfBytes_ Number of bytes.
@@ -116,6 +115,14 @@ void Spi2DmaTxDeinitialise(void) {
  */
 void Spi2DmaTxTransfer(const GPIO_PIN csPin_, volatile void* const data, const size_t numberOfBytes, void (*const transferComplete_) (void)) {
 
+    // Complete transfer without transmitting data if DMA channel not allocated
+    if (txDma == NULL) {
+        if (transferComplete_ != NULL) {
+            transferComplete_();
+        }
+        return;
+    }
+
     // Store arguments
     csPin = csPin_;
     transferComplete = transferComplete_;
@@ -126,8 +133,8 @@ void Spi2DmaTxTransfer(const GPIO_PIN csPin_, volatile void* const data, const s
 #endif
 
     // Configure TX DMA channel
-    DCH0SSA = KVA_TO_PA(data); // source address
-    DCH0SSIZ = numberOfBytes; // source size
+    txDma->registers->DCHxSSA = KVA_TO_PA(data); // source address
+    txDma->registers->DCHxSSIZ = numberOfBytes; // source size
 
     // Begin transfer
     if (csPin != GPIO_PIN_NONE) {
@@ -137,16 +144,15 @@ void Spi2DmaTxTransfer(const GPIO_PIN csPin_, volatile void* const data, const s
         GPIO_PinClear(csPin);
 #endif
     }
-    DCH0INTbits.CHBCIF = 0; // clear TX DMA channel interrupt flag
-    DCH0CONbits.CHEN = 1; // enable TX DMA channel to begin transfer
+    txDma->registers->DCHxINTbits.CHBCIF = 0; // clear TX DMA channel interrupt flag
+    txDma->registers->DCHxCONbits.CHEN = 1; // enable TX DMA channel to begin transfer
 }
 
 /**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
+ * @brief TX DMA channel interrupt handler.
  */
-void Dma0InterruptHandler(void) {
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0); // clear interrupt flag first because callback may start new transfer
+static void TxDmaInterruptHandler(void) {
+    EVIC_SourceStatusClear(txDma->interruptSource); // clear interrupt flag first because callback may start new transfer
     if (csPin != GPIO_PIN_NONE) {
 #ifdef SPI2_CS_ACTIVE_HIGH
         GPIO_PinClear(csPin);
@@ -164,7 +170,7 @@ void Dma0InterruptHandler(void) {
  * @return True while the transfer is in progress.
  */
 bool Spi2DmaTxTransferInProgress(void) {
-    return DCH0CONbits.CHEN == 1; // if TX DMA channel enabled
+    return (txDma != NULL) && (txDma->registers->DCHxCONbits.CHEN == 1); // if TX DMA channel enabled
 }
 
 //------------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 // Includes
 
 #include "definitions.h"
+#include "Dma/Dma.h"
 #include "Spi4Dma.h"
 #include "sys/kmem.h"
 
@@ -19,6 +20,11 @@
  */
 //#define PRINT_TRANSFERS
 
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void RxDmaInterruptHandler(void);
+
 //------------------------------------------------------------------------------
 // Variables
 
@@ -27,6 +33,8 @@ const Spi spi4Dma = {
     .transferInProgress = Spi4DmaTransferInProgress,
 };
 
+static DmaChannel* txDma;
+static DmaChannel* rxDma;
 static GPIO_PIN csPin;
 #ifdef PRINT_TRANSFERS
 static void* data;
@@ -57,34 +65,39 @@ void Spi4DmaInitialise(const SpiSettings * const settings) {
     SPI4BRG = SpiCalculateSpixbrg(settings->clockFrequency);
     SPI4CONbits.ON = 1;
 
-    // Enable DMA
-    DMACONbits.ON = 1;
+    // Allocate DMA channels
+    txDma = DmaAllocate(NULL);
+    rxDma = DmaAllocate(RxDmaInterruptHandler);
+    if ((txDma == NULL) || (rxDma == NULL)) {
+        Spi4DmaDeinitialise();
+        return;
+    }
 
     // Configure TX DMA channel
 #ifdef _SPI4_TX_IRQ
-    DCH0ECONbits.CHSIRQ = _SPI4_TX_IRQ; // channel transfer start IRQ
+    txDma->registers->DCHxECONbits.CHSIRQ = _SPI4_TX_IRQ; // channel transfer start IRQ
 #else
-    DCH0ECONbits.CHSIRQ = _SPI4_TX_VECTOR; // channel transfer start IRQ
+    txDma->registers->DCHxECONbits.CHSIRQ = _SPI4_TX_VECTOR; // channel transfer start IRQ
 #endif
-    DCH0ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH0DSA = KVA_TO_PA(&SPI4BUF); // destination address
-    DCH0DSIZ = 1; // destination size
-    DCH0CSIZ = 1; // transfers per event
+    txDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+    txDma->registers->DCHxDSA = KVA_TO_PA(&SPI4BUF); // destination address
+    txDma->registers->DCHxDSIZ = 1; // destination size
+    txDma->registers->DCHxCSIZ = 1; // transfers per event
 
     // Configure RX DMA channel
 #ifdef _SPI4_RX_IRQ
-    DCH1ECONbits.CHSIRQ = _SPI4_RX_IRQ; // channel transfer start IRQ
+    rxDma->registers->DCHxECONbits.CHSIRQ = _SPI4_RX_IRQ; // channel transfer start IRQ
 #else
-    DCH1ECONbits.CHSIRQ = _SPI4_RX_VECTOR; // channel transfer start IRQ
+    rxDma->registers->DCHxECONbits.CHSIRQ = _SPI4_RX_VECTOR; // channel transfer start IRQ
 #endif
-    DCH1ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH1SSA = KVA_TO_PA(&SPI4BUF); // source address
-    DCH1SSIZ = 1; // source size
-    DCH1CSIZ = 1; // transfers per event
-    DCH1INTbits.CHBCIE = 1; // channel Block Transfer Complete Interrupt Enable bit
+    rxDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+    rxDma->registers->DCHxSSA = KVA_TO_PA(&SPI4BUF); // source address
+    rxDma->registers->DCHxSSIZ = 1; // source size
+    rxDma->registers->DCHxCSIZ = 1; // transfers per event
+    rxDma->registers->DCHxINTbits.CHBCIE = 1; // channel Block Transfer Complete Interrupt Enable bit
 
     // Configure RX DMA channel interrupt
-    EVIC_SourceEnable(INT_SOURCE_DMA1);
+    EVIC_SourceEnable(rxDma->interruptSource);
 }
 
 /**
@@ -99,36 +112,12 @@ void Spi4DmaDeinitialise(void) {
     SPI4BRG = 0;
 
     // Disable TX DMA channel and restore default register states
-    DCH0CON = 0;
-    DCH0ECON = 0;
-    DCH0INT = 0;
-    DCH0SSA = 0;
-    DCH0DSA = 0;
-    DCH0SSIZ = 0;
-    DCH0DSIZ = 0;
-    DCH0SPTR = 0;
-    DCH0DPTR = 0;
-    DCH0CSIZ = 0;
-    DCH0CPTR = 0;
-    DCH0DAT = 0;
+    DmaFree(txDma);
+    txDma = NULL;
 
     // Disable RX DMA channel and restore default register states
-    DCH1CON = 0;
-    DCH1ECON = 0;
-    DCH1INT = 0;
-    DCH1SSA = 0;
-    DCH1DSA = 0;
-    DCH1SSIZ = 0;
-    DCH1DSIZ = 0;
-    DCH1SPTR = 0;
-    DCH1DPTR = 0;
-    DCH1CSIZ = 0;
-    DCH1CPTR = 0;
-    DCH1DAT = 0;
-
-    // Disable interrupt
-    EVIC_SourceDisable(INT_SOURCE_DMA1);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
+    DmaFree(rxDma);
+    rxDma = NULL;
 }
 
 /**
@@ -136,7 +125,9 @@ void Spi4DmaDeinitialise(void) {
  * The data must be declared __attribute__((coherent)) for PIC32MZ devices.
  * This function must not be called while a transfer is in progress. The
  * transfer complete callback will be called from within an interrupt once the
- * transfer is complete.
+ * transfer is complete. The transfer complete callback will be called
+ * immediately and the data will be unchanged if the DMA channels were not
+ * allocated.
  * @param csPin_ CS pin.
  * @param data_ Data.
  * @param numberOfBytes_ Number of bytes.
@@ -144,6 +135,14 @@ void Spi4DmaDeinitialise(void) {
  */
 void Spi4DmaTransfer(const GPIO_PIN csPin_, volatile void* const data_, const size_t numberOfBytes_, void (*const transferComplete_) (void)) {
 
+    // Complete transfer without transferring data if DMA channels not allocated
+    if (rxDma == NULL) {
+        if (transferComplete_ != NULL) {
+            transferComplete_();
+        }
+        return;
+    }
+
     // Store arguments
     csPin = csPin_;
 #ifdef PRINT_TRANSFERS
@@ -158,12 +157,12 @@ void Spi4DmaTransfer(const GPIO_PIN csPin_, volatile void* const data_, const si
 #endif
 
     // Configure TX DMA channel
-    DCH0SSA = KVA_TO_PA(data_); // source address
-    DCH0SSIZ = numberOfBytes_; // source size
+    txDma->registers->DCHxSSA = KVA_TO_PA(data_); // source address
+    txDma->registers->DCHxSSIZ = numberOfBytes_; // source size
 
     // Configure RX DMA channel
-    DCH1DSA = KVA_TO_PA(data_); // destination address
-    DCH1DSIZ = numberOfBytes_; // destination size
+    rxDma->registers->DCHxDSA = KVA_TO_PA(data_); // destination address
+    rxDma->registers->DCHxDSIZ = numberOfBytes_; // destination size
 
     // Begin transfer
     if (csPin != GPIO_PIN_NONE) {
@@ -173,17 +172,16 @@ void Spi4DmaTransfer(const GPIO_PIN csPin_, volatile void* const data_, const si
         GPIO_PinClear(csPin);
 #endif
     }
-    DCH1INTbits.CHBCIF = 0; // clear RX DMA channel interrupt flag
-    DCH1CONbits.CHEN = 1; // enable RX DMA channel
-    DCH0CONbits.CHEN = 1; // enable TX DMA channel to begin transfer
+    rxDma->registers->DCHxINTbits.CHBCIF = 0; // clear RX DMA channel interrupt flag
+    rxDma->registers->DCHxCONbits.CHEN = 1; // enable RX DMA channel
+    txDma->registers->DCHxCONbits.CHEN = 1; // enable TX DMA channel to begin transfer
 }
 
 /**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
+ * @brief RX DMA channel interrupt handler.
  */
-void Dma1InterruptHandler(void) {
-    EVIC_SourceStatusClear(INT_SOURCE_DMA1); // clear interrupt flag first because transfer complete callback may start a new transfer
+static void RxDmaInterruptHandler(void) {
+    EVIC_SourceStatusClear(rxDma->interruptSource); // clear interrupt flag first because transfer complete callback may start a new transfer
     if (csPin != GPIO_PIN_NONE) {
 #ifdef SPI4_CS_ACTIVE_HIGH
         GPIO_PinClear(csPin);
@@ -204,7 +202,7 @@ void Dma1InterruptHandler(void) {
  * @return True while the transfer is in progress.
  */
 bool Spi4DmaTransferInProgress(void) {
-    return DCH1CONbits.CHEN == 1; // if RX DMA channel enabled
+    return (rxDma != NULL) && (rxDma->registers->DCHxCONbits.CHEN == 1); // if RX DMA channel enabled
 }
 
 //------------------------------------------------------------------------------
@@ -34,6 +34,11 @@
  */
 #define HOLDOFF_PERIOD (TIMER_TICKS_PER_SECOND / 10U)
 
+/**
+ * @brief FIFO of data.
+ */
+FIFO_TYPED(DataFifo, SyncData, 128)
+
 //------------------------------------------------------------------------------
 // Function declarations
 
@@ -48,18 +53,21 @@ static const InputCaptureSettings inputCaptureSettings = {.edge = InputCaptureEd
 static volatile bool edge = inputCaptureSettings.firstEdge;
 static volatile uint64_t holdoffTimeout;
 static volatile int captureError; // __sync_lock_test_and_set cannot be used with bool
-static uint8_t fifoData[(128 * sizeof (SyncData)) + 1]; // FIFO capacity is 1 less than size
-static Fifo fifo = {.data = fifoData, .dataSize = sizeof (fifoData)};
+static DataFifo fifo;
 static volatile uint32_t bufferOverflow;
+static bool bufferOverwrite;
 
 //------------------------------------------------------------------------------
 // Functions
 
 /**
  * @brief Initialises the module.
+ * @param bufferOverwrite_ True to discard the oldest edges if the buffer is
+ * full, otherwise the newest edges are discarded.
  */
-void SyncInitialise(void) {
+void SyncInitialise(const bool bufferOverwrite_) {
     SyncDeinitialise();
+    bufferOverwrite = bufferOverwrite_;
     SYNC_INPUT_CAPTURE.initialise(&inputCaptureSettings, CaptureEvent);
 }
 
@@ -71,7 +79,7 @@ void SyncDeinitialise(void) {
     edge = inputCaptureSettings.firstEdge;
     holdoffTimeout = 0;
     captureError = 0;
-    FifoClear(&fifo);
+    DataFifoClear(&fifo);
     bufferOverflow = 0;
 }
 
@@ -122,7 +130,9 @@ static void CaptureEvent(const uint64_t ticks) {
         .ticks = ticks,
         .edge = edge,
     };
-    if (FifoWrite(&fifo, &fifoPacket, sizeof (fifoPacket)) != FifoResultOk) {
+    if (bufferOverwrite) {
+        bufferOverflow += DataFifoWriteOverwrite(&fifo, &fifoPacket);
+    } else if (DataFifoWrite(&fifo, &fifoPacket) != FifoResultOk) {
         bufferOverflow++;
     }
     edge ^= true;
@@ -164,15 +174,17 @@ bool SyncCaptureError(void) {
  * @return Result.
  */
 SyncResult SyncGetData(SyncData * const data) {
-    if (FifoRead(&fifo, data, sizeof (SyncData)) == 0) {
+    if (DataFifoRead(&fifo, data) != FifoResultOk) {
         return SyncResultError;
     }
     return SyncResultOk;
 }
 
 /**
- * @brief Returns the number of edges lost due to buffer overflow. Calling
- * this function will reset the value.
+ * @brief Returns the number of edges lost due to buffer overflow. The oldest
+ * edges are lost if buffer overwrite was selected at initialisation,
+ * otherwise the newest edges are lost. Calling this function will reset the
+ * value.
  * @return Number of edges lost due to buffer overflow.
  */
 uint32_t SyncBufferOverflow(void) {
@@ -35,7 +35,7 @@ typedef struct {
 //------------------------------------------------------------------------------
 // Function declarations
 
-void SyncInitialise(void);
+void SyncInitialise(const bool bufferOverwrite_);
 void SyncDeinitialise(void);
 void SyncTasks(void);
 bool SyncCaptureError(void);
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include <math.h>
 #include "PeripheralBusClockFrequency.h"
 #include "Uart.h"
 
@@ -24,6 +25,16 @@
 #error "Unsupported device."
 #endif
 
+/**
+ * @brief Maximum UxBRG value.
+ */
+#define UXBRG_MAX (0xFFFF)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void PlanCandidate(UartBaudRatePlan * const plan, const uint32_t baudRate, const bool brgh, const uint64_t multiplier);
+
 //------------------------------------------------------------------------------
 // Variables
 
@@ -33,13 +44,22 @@ const UartSettings uartSettingsDefault = {
     .parityAndData = UartParityAndDataEightNone,
     .stopBits = UartStopBitsOne,
     .invertTxRx = false,
+    .softwareRtsEnabled = false,
+    .rtsPin = GPIO_PIN_NONE,
+    .rtsStopSpace = 256,
+    .rtsStartSpace = 512,
+    .adaptiveRxInterrupt = false,
+    .rs485Enabled = false,
+    .rs485DriverEnablePin = GPIO_PIN_NONE,
+    .addressDetectEnabled = false,
+    .address = 0,
 };
 
 //------------------------------------------------------------------------------
 // Functions
 
 /**
- * @brief Calculates the UxBRG value for a target baud rate.
+ * @brief Calculates the UxBRG value for a target baud rate with BRGH = 1.
  * See page 13 of Section 21. UART.
  * @param baudRate Baud rate.
  * @return UxBRG value.
@@ -50,7 +70,7 @@ uint32_t UartCalculateUxbrg(const uint32_t baudRate) {
 }
 
 /**
- * @brief Calculates the actual baud rate for a UxBRG value.
+ * @brief Calculates the actual baud rate for a UxBRG value with BRGH = 1.
  * See page 13 of Section 21. UART.
  * @param uxbrg UxBRG value.
  * @return Baud rate.
@@ -59,5 +79,62 @@ float UartCalculateBaudRate(const uint32_t uxbrg) {
     return (float) UART_PERIPHERAL_CLOCK / (4.0f * ((float) uxbrg + 1.0f));
 }
 
+/**
+ * @brief Plans the BRGH and UxBRG values for a target baud rate. Both BRGH
+ * modes are evaluated and the plan with the lowest error is selected. Standard
+ * mode is selected if the errors are equal because of the greater number of
+ * samples per bit. The error is infinite if the baud rate is zero.
+ * @param baudRate Baud rate.
+ * @return Baud rate plan.
+ */
+UartBaudRatePlan UartPlanBaudRate(const uint32_t baudRate) {
+    UartBaudRatePlan plan = {.error = INFINITY};
+    if (baudRate == 0) {
+        return plan;
+    }
+    PlanCandidate(&plan, baudRate, false, 16);
+    PlanCandidate(&plan, baudRate, true, 4);
+    return plan;
+}
+
+/**
+ * @brief Updates the plan if a UxBRG value either side of the ideal value has
+ * a lower error.
+ * @param plan Baud rate plan.
+ * @param baudRate Baud rate.
+ * @param brgh BRGH value.
+ * @param multiplier Baud clock multiplier for BRGH value.
+ */
+static void PlanCandidate(UartBaudRatePlan * const plan, const uint32_t baudRate, const bool brgh, const uint64_t multiplier) {
+    const uint64_t idealDivider = (uint64_t) UART_PERIPHERAL_CLOCK / (multiplier * baudRate); // UxBRG + 1
+    for (uint64_t divider = idealDivider; divider <= (idealDivider + 1); divider++) {
+        uint32_t uxbrg = UXBRG_MAX; // limit to range of UxBRG
+        if (divider < 1) {
+            uxbrg = 0;
+        } else if (divider <= (UXBRG_MAX + 1)) {
+            uxbrg = divider - 1;
+        }
+        const float actualBaudRate = UartCalculateActualBaudRate(brgh, uxbrg);
+        const float error = ((actualBaudRate - (float) baudRate) / (float) baudRate) * 1E6f;
+        if (fabsf(error) < fabsf(plan->error)) {
+            plan->brgh = brgh;
+            plan->uxbrg = uxbrg;
+            plan->baudRate = actualBaudRate;
+            plan->error = error;
+        }
+    }
+}
+
+/**
+ * @brief Calculates the actual baud rate for BRGH and UxBRG values.
+ * See page 13 of Section 21. UART.
+ * @param brgh BRGH value.
+ * @param uxbrg UxBRG value.
+ * @return Baud rate.
+ */
+float UartCalculateActualBaudRate(const bool brgh, const uint32_t uxbrg) {
+    return (float) UART_PERIPHERAL_CLOCK / ((brgh ? 4.0f : 16.0f) * ((float) uxbrg + 1.0f));
+}
+
 //------------------------------------------------------------------------------
 // End of file
@@ -10,12 +10,22 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "definitions.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 //------------------------------------------------------------------------------
 // Definitions
 
+/**
+ * @brief Result.
+ */
+typedef enum {
+    UartResultOk,
+    UartResultError,
+} UartResult;
+
 /**
  * @brief Parity and data. Values equal to PDSEL bits of UxMODE register.
  */
@@ -43,8 +53,93 @@ typedef struct {
     UartParityAndData parityAndData;
     UartStopBits stopBits;
     bool invertTxRx;
+    bool softwareRtsEnabled;
+    GPIO_PIN rtsPin; // software RTS output
+    size_t rtsStopSpace; // RTS deasserted when read buffer space falls to this number of bytes, must be less than read buffer size, interrupt and stream read modes only
+    size_t rtsStartSpace; // RTS asserted when read buffer space rises to this number of bytes, interrupt and stream read modes only
+    bool adaptiveRxInterrupt; // RX interrupt threshold adapted to receive rate, interrupt driver only, requires UartNTasks
+    bool rs485Enabled;
+    GPIO_PIN rs485DriverEnablePin; // RS-485 driver enable output
+    bool addressDetectEnabled; // requires UartParityAndDataNineNone
+    uint8_t address; // 9-bit address detect address character
 } UartSettings;
 
+/**
+ * @brief Baud rate plan. The error is the difference between the actual and
+ * requested baud rate.
+ */
+typedef struct {
+    bool brgh; // true = high-speed mode (4x baud clock), false = standard mode (16x baud clock)
+    uint32_t uxbrg;
+    float baudRate; // actual baud rate
+    float error; // ppm
+} UartBaudRatePlan;
+
+/**
+ * @brief Statistics.
+ */
+typedef struct {
+    float rxInterruptsPerSecond;
+    float txInterruptsPerSecond;
+    float rxBytesPerSecond;
+    uint32_t urxisel; // current URXISEL value
+} UartStatistics;
+
+/**
+ * @brief Software RTS. RTS is deasserted (high) when the read buffer space
+ * falls to the stop watermark and asserted (low) when the read buffer space
+ * rises to the start watermark. DMA read modes without a read buffer instead
+ * deassert RTS while the read callback runs or, if the read mode is deferred,
+ * while reads are paused. The RTS pin must be configured as a GPIO output.
+ * Hardware CTS may still be used by setting rtsCtsEnabled and not mapping the
+ * UxRTS output to a pin. All structure members are private.
+ */
+typedef struct {
+    bool enabled;
+    GPIO_PIN pin;
+    size_t stopSpace;
+    size_t startSpace;
+} UartRts;
+
+/**
+ * @brief RS-485 driver enable. The driver enable is asserted (high) before
+ * data is transmitted and released (low) once all characters have been
+ * transmitted. The driver enable pin must be configured as a GPIO output. All
+ * structure members are private.
+ */
+typedef struct {
+    bool enabled;
+    GPIO_PIN pin;
+} UartRs485;
+
+/**
+ * @brief UART registers. The register layout is the same for all UARTs.
+ */
+typedef struct {
+    union {
+        volatile uint32_t UxMODE;
+        volatile __U1MODEbits_t UxMODEbits;
+    };
+    volatile uint32_t UxMODECLR;
+    volatile uint32_t UxMODESET;
+    volatile uint32_t UxMODEINV;
+    union {
+        volatile uint32_t UxSTA;
+        volatile __U1STAbits_t UxSTAbits;
+    };
+    volatile uint32_t UxSTACLR;
+    volatile uint32_t UxSTASET;
+    volatile uint32_t UxSTAINV;
+    volatile uint32_t UxTXREG;
+    volatile uint32_t reserved0[3];
+    volatile uint32_t UxRXREG;
+    volatile uint32_t reserved1[3];
+    volatile uint32_t UxBRG;
+    volatile uint32_t UxBRGCLR;
+    volatile uint32_t UxBRGSET;
+    volatile uint32_t UxBRGINV;
+} UartRegisters;
+
 //------------------------------------------------------------------------------
 // Variable declarations
 
@@ -55,6 +150,120 @@ extern const UartSettings uartSettingsDefault;
 
 uint32_t UartCalculateUxbrg(const uint32_t baudRate);
 float UartCalculateBaudRate(const uint32_t uxbrg);
+UartBaudRatePlan UartPlanBaudRate(const uint32_t baudRate);
+float UartCalculateActualBaudRate(const bool brgh, const uint32_t uxbrg);
+
+//------------------------------------------------------------------------------
+// Inline functions
+
+/**
+ * @brief Initialises software RTS. RTS is asserted if enabled.
+ * @param rts Software RTS structure.
+ * @param settings Settings.
+ */
+static inline __attribute__((always_inline)) void UartRtsInitialise(UartRts * const rts, const UartSettings * const settings) {
+    rts->enabled = settings->softwareRtsEnabled;
+    rts->pin = settings->rtsPin;
+    rts->stopSpace = settings->rtsStopSpace;
+    rts->startSpace = settings->rtsStartSpace;
+    if (rts->enabled) {
+        GPIO_PinClear(rts->pin);
+    }
+}
+
+/**
+ * @brief Deinitialises software RTS. RTS is deasserted if enabled.
+ * @param rts Software RTS structure.
+ */
+static inline __attribute__((always_inline)) void UartRtsDeinitialise(UartRts * const rts) {
+    if (rts->enabled) {
+        GPIO_PinSet(rts->pin);
+    }
+    rts->enabled = false;
+}
+
+/**
+ * @brief Updates software RTS. This function must be called each time data is
+ * written to or read from the read buffer.
+ * @param rts Software RTS structure.
+ * @param space Space available in the read buffer.
+ */
+static inline __attribute__((always_inline)) void UartRtsUpdate(const UartRts * const rts, const size_t space) {
+    if (rts->enabled == false) {
+        return;
+    }
+    if (space <= rts->stopSpace) {
+        GPIO_PinSet(rts->pin);
+    } else if (space >= rts->startSpace) {
+        GPIO_PinClear(rts->pin);
+    }
+}
+
+/**
+ * @brief Deasserts software RTS.
+ * @param rts Software RTS structure.
+ */
+static inline __attribute__((always_inline)) void UartRtsDeassert(const UartRts * const rts) {
+    if (rts->enabled) {
+        GPIO_PinSet(rts->pin);
+    }
+}
+
+/**
+ * @brief Asserts software RTS.
+ * @param rts Software RTS structure.
+ */
+static inline __attribute__((always_inline)) void UartRtsAssert(const UartRts * const rts) {
+    if (rts->enabled) {
+        GPIO_PinClear(rts->pin);
+    }
+}
+
+/**
+ * @brief Initialises the RS-485 driver enable. The driver enable is released
+ * if enabled.
+ * @param rs485 RS-485 driver enable structure.
+ * @param settings Settings.
+ */
+static inline __attribute__((always_inline)) void UartRs485Initialise(UartRs485 * const rs485, const UartSettings * const settings) {
+    rs485->enabled = settings->rs485Enabled;
+    rs485->pin = settings->rs485DriverEnablePin;
+    if (rs485->enabled) {
+        GPIO_PinClear(rs485->pin);
+    }
+}
+
+/**
+ * @brief Deinitialises the RS-485 driver enable. The driver enable is released
+ * if enabled.
+ * @param rs485 RS-485 driver enable structure.
+ */
+static inline __attribute__((always_inline)) void UartRs485Deinitialise(UartRs485 * const rs485) {
+    if (rs485->enabled) {
+        GPIO_PinClear(rs485->pin);
+    }
+    rs485->enabled = false;
+}
+
+/**
+ * @brief Asserts the RS-485 driver enable.
+ * @param rs485 RS-485 driver enable structure.
+ */
+static inline __attribute__((always_inline)) void UartRs485Transmit(const UartRs485 * const rs485) {
+    if (rs485->enabled) {
+        GPIO_PinSet(rs485->pin);
+    }
+}
+
+/**
+ * @brief Releases the RS-485 driver enable.
+ * @param rs485 RS-485 driver enable structure.
+ */
+static inline __attribute__((always_inline)) void UartRs485Receive(const UartRs485 * const rs485) {
+    if (rs485->enabled) {
+        GPIO_PinClear(rs485->pin);
+    }
+}
 
 #endif
 
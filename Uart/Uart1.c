@@ -1,7 +1,7 @@
 /**
  * @file Uart1.c
  * @author Seb Madgwick
- * @brief UART driver for PIC32 devices.
+ * @brief UART driver for PIC32 devices. Wrapper of UartCore.
  */
 
 //------------------------------------------------------------------------------
@@ -10,21 +10,20 @@
 #include "Config.h"
 #include "definitions.h"
 #include "Uart1.h"
-
-//------------------------------------------------------------------------------
-// Function declarations
-
-static inline __attribute__((always_inline)) void RxInterruptTasks(void);
-static inline __attribute__((always_inline)) void TxInterruptTasks(void);
+#include "UartCore.h"
 
 //------------------------------------------------------------------------------
 // Variables
 
-static bool receiveBufferOverrun;
 static uint8_t readData[UART1_READ_BUFFER_SIZE];
-static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
 static uint8_t writeData[UART1_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+static UartCore uart = {
+    .registers = (UartRegisters*) &U1MODE,
+    .rxInterruptSource = INT_SOURCE_UART1_RX,
+    .txInterruptSource = INT_SOURCE_UART1_TX,
+    .readFifo = {.data = readData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (readData))},
+    .writeFifo = {.data = writeData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (writeData))},
+};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -32,53 +31,25 @@ static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
 /**
  * @brief Initialises the module.
  * @param settings Settings.
+ * @return Result. UartResultError if the baud rate is zero.
  */
-void Uart1Initialise(const UartSettings * const settings) {
-
-    // Ensure default register states
-    Uart1Deinitialise();
-
-    // Configure UART
-    if (settings->rtsCtsEnabled) {
-        U1MODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-    }
-    if (settings->invertTxRx) {
-        U1MODEbits.RXINV = 1; // UxRX Idle state is '0'
-        U1STAbits.UTXINV = 1; // UxTX Idle state is '0'
-    }
-    U1MODEbits.PDSEL = settings->parityAndData;
-    U1MODEbits.STSEL = settings->stopBits;
-    U1MODEbits.BRGH = 1; // high-Speed mode - 4x baud clock enabled
-    U1STAbits.URXISEL = 0b01; // interrupt flag bit is asserted while receive buffer is 1/2 or more full (i.e., has 4 or more data characters)
-    U1STAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
-    U1STAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
-    U1STAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
-    U1BRG = UartCalculateUxbrg(settings->baudRate);
-    U1MODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
-
-    // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_UART1_RX);
+UartResult Uart1Initialise(const UartSettings * const settings) {
+    return UartCoreInitialise(&uart, settings);
 }
 
 /**
  * @brief Deinitialises the module.
  */
 void Uart1Deinitialise(void) {
+    UartCoreDeinitialise(&uart);
+}
 
-    // Disable UART and restore default register states
-    U1MODE = 0;
-    U1STA = 0;
-
-    // Disable interrupts
-    EVIC_SourceDisable(INT_SOURCE_UART1_RX);
-    EVIC_SourceDisable(INT_SOURCE_UART1_TX);
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_RX);
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_TX);
-
-    // Clear buffers
-    receiveBufferOverrun = false;
-    Uart1ClearReadBuffer();
-    Uart1ClearWriteBuffer();
+/**
+ * @brief Module tasks. This function should be called repeatedly within the
+ * main program loop if the adaptive RX interrupt threshold is enabled.
+ */
+void Uart1Tasks(void) {
+    UartCoreTasks(&uart);
 }
 
 /**
@@ -86,21 +57,7 @@ void Uart1Deinitialise(void) {
  * @return Number of bytes available in the read buffer.
  */
 size_t Uart1AvailableRead(void) {
-
-    // Trigger RX interrupt if receive buffer not empty
-    if (U1STAbits.URXDA == 1) {
-        EVIC_SourceEnable(INT_SOURCE_UART1_RX);
-        EVIC_SourceStatusSet(INT_SOURCE_UART1_RX);
-    }
-
-    // Clear receive buffer overrun flag
-    if (U1STAbits.OERR == 1) {
-        U1STAbits.OERR = 0;
-        receiveBufferOverrun = true;
-    }
-
-    // Return number of bytes
-    return FifoAvailableRead(&readFifo);
+    return UartCoreAvailableRead(&uart);
 }
 
 /**
@@ -110,8 +67,18 @@ size_t Uart1AvailableRead(void) {
  * @return Number of bytes read.
  */
 size_t Uart1Read(void* const destination, size_t numberOfBytes) {
-    Uart1AvailableRead(); // process receive buffer
-    return FifoRead(&readFifo, destination, numberOfBytes);
+    return UartCoreRead(&uart, destination, numberOfBytes);
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult Uart1Find(const uint8_t byte, size_t * const offset) {
+    return UartCoreFind(&uart, byte, offset);
 }
 
 /**
@@ -120,7 +87,7 @@ size_t Uart1Read(void* const destination, size_t numberOfBytes) {
  * @return Byte.
  */
 uint8_t Uart1ReadByte(void) {
-    return FifoReadByte(&readFifo);
+    return UartCoreReadByte(&uart);
 }
 
 /**
@@ -128,7 +95,7 @@ uint8_t Uart1ReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart1AvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return UartCoreAvailableWrite(&uart);
 }
 
 /**
@@ -138,9 +105,18 @@ size_t Uart1AvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart1Write(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
-    EVIC_SourceEnable(INT_SOURCE_UART1_TX);
-    return result;
+    return UartCoreWrite(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart1Writev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartCoreWritev(&uart, vectors, numberOfVectors);
 }
 
 /**
@@ -149,24 +125,21 @@ FifoResult Uart1Write(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult Uart1WriteByte(const uint8_t byte) {
-    const FifoResult result = FifoWriteByte(&writeFifo, byte);
-    EVIC_SourceEnable(INT_SOURCE_UART1_TX);
-    return result;
+    return UartCoreWriteByte(&uart, byte);
 }
 
 /**
  * @brief Clears the read buffer and resets the read buffer overrun flag.
  */
 void Uart1ClearReadBuffer(void) {
-    FifoClear(&readFifo);
-    Uart1ReceiveBufferOverrun(); // clear flag
+    UartCoreClearReadBuffer(&uart);
 }
 
 /**
  * @brief Clears the write buffer.
  */
 void Uart1ClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    UartCoreClearWriteBuffer(&uart);
 }
 
 /**
@@ -175,11 +148,7 @@ void Uart1ClearWriteBuffer(void) {
  * @return True if the receive buffer has overrun.
  */
 bool Uart1ReceiveBufferOverrun(void) {
-    if (receiveBufferOverrun) {
-        receiveBufferOverrun = false;
-        return true;
-    }
-    return false;
+    return UartCoreReceiveBufferOverrun(&uart);
 }
 
 /**
@@ -187,7 +156,43 @@ bool Uart1ReceiveBufferOverrun(void) {
  * @return True if all data has been transmitted.
  */
 bool Uart1TransmissionComplete(void) {
-    return (EVIC_SourceIsEnabled(INT_SOURCE_UART1_TX) == false) && (U1STAbits.TRMT == 1);
+    return UartCoreTransmissionComplete(&uart);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ */
+void Uart1StartAutoBaud(void) {
+    UartCoreStartAutoBaud(&uart);
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @return True while auto-baud is in progress.
+ */
+bool Uart1AutoBaudInProgress(void) {
+    return UartCoreAutoBaudInProgress(&uart);
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @return Baud rate.
+ */
+float Uart1GetBaudRate(void) {
+    return UartCoreGetBaudRate(&uart);
+}
+
+/**
+ * @brief Gets the statistics. Rates are calculated from the counts since the
+ * previous call.
+ * @param statistics Statistics.
+ */
+void Uart1GetStatistics(UartStatistics * const statistics) {
+    UartCoreGetStatistics(&uart, statistics);
 }
 
 #ifdef _UART_1_VECTOR
@@ -197,19 +202,7 @@ bool Uart1TransmissionComplete(void) {
  * the ISR implementation generated by MPLAB Harmony.
  */
 void Uart1InterruptHandler(void) {
-
-    // RX interrupt
-    if (EVIC_SourceStatusGet(INT_SOURCE_UART1_RX)) {
-        RxInterruptTasks();
-    }
-
-    // TX interrupt
-    if (EVIC_SourceIsEnabled(INT_SOURCE_UART1_TX) == false) {
-        return; // return if TX interrupt disabled because TX interrupt flag will remain set while the transmit buffer is empty
-    }
-    if (EVIC_SourceStatusGet(INT_SOURCE_UART1_TX)) {
-        TxInterruptTasks();
-    }
+    UartCoreInterruptHandler(&uart);
 }
 
 #else
@@ -219,7 +212,7 @@ void Uart1InterruptHandler(void) {
  * implementation generated by MPLAB Harmony.
  */
 void Uart1RxInterruptHandler(void) {
-    RxInterruptTasks();
+    UartCoreRxInterruptHandler(&uart);
 }
 
 /**
@@ -227,39 +220,10 @@ void Uart1RxInterruptHandler(void) {
  * implementation generated by MPLAB Harmony.
  */
 void Uart1TxInterruptHandler(void) {
-    TxInterruptTasks();
+    UartCoreTxInterruptHandler(&uart);
 }
 
 #endif
 
-/**
- * @brief UART RX interrupt tasks.
- */
-static inline __attribute__((always_inline)) void RxInterruptTasks(void) {
-    while (U1STAbits.URXDA == 1) { // while data available in receive buffer
-        if (FifoAvailableWrite(&readFifo) == 0) { // if read buffer full
-            EVIC_SourceDisable(INT_SOURCE_UART1_RX);
-            break;
-        }
-        FifoWriteByte(&readFifo, U1RXREG);
-    }
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_RX);
-}
-
-/**
- * @brief UART TX interrupt tasks.
- */
-static inline __attribute__((always_inline)) void TxInterruptTasks(void) {
-    EVIC_SourceDisable(INT_SOURCE_UART1_TX); // disable TX interrupt to avoid nested interrupt
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_TX);
-    while (U1STAbits.UTXBF == 0) { // while transmit buffer not full
-        if (FifoAvailableRead(&writeFifo) == 0) { // if write buffer empty
-            return;
-        }
-        U1TXREG = FifoReadByte(&writeFifo);
-    }
-    EVIC_SourceEnable(INT_SOURCE_UART1_TX); // re-enable TX interrupt
-}
-
 //------------------------------------------------------------------------------
 // End of file
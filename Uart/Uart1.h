@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart1Initialise(const UartSettings * const settings);
+UartResult Uart1Initialise(const UartSettings * const settings);
 void Uart1Deinitialise(void);
+void Uart1Tasks(void);
 size_t Uart1AvailableRead(void);
 size_t Uart1Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart1ReadByte(void);
+FifoResult Uart1Find(const uint8_t byte, size_t * const offset);
 size_t Uart1AvailableWrite(void);
 FifoResult Uart1Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart1WriteByte(const uint8_t byte);
 void Uart1ClearReadBuffer(void);
 void Uart1ClearWriteBuffer(void);
 bool Uart1ReceiveBufferOverrun(void);
 bool Uart1TransmissionComplete(void);
+void Uart1StartAutoBaud(void);
+bool Uart1AutoBaudInProgress(void);
+float Uart1GetBaudRate(void);
+void Uart1GetStatistics(UartStatistics * const statistics);
 
 #endif
 
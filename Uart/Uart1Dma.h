@@ -1,7 +1,10 @@
 /**
  * @file Uart1Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart1TxInterruptHandler, or
+ * Uart1InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART1_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart1DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart1DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart1DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart1DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart1DmaDeinitialise(void);
 void Uart1DmaTasks(void);
+size_t Uart1DmaAvailableRead(void);
+size_t Uart1DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart1DmaReadByte(void);
+void Uart1DmaClearReadBuffer(void);
 size_t Uart1DmaAvailableWrite(void);
 FifoResult Uart1DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart1DmaWriteBreak(void);
+size_t Uart1DmaAvailableWriteHighPriority(void);
+FifoResult Uart1DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart1DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart1DmaWriteTransferInProgress(void);
 void Uart1DmaClearWriteBuffer(void);
+void Uart1DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart1DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart1DmaReceiveBufferOverrun(void);
 bool Uart1DmaTransmissionComplete(void);
+void Uart1DmaStartAutoBaud(void);
+bool Uart1DmaAutoBaudInProgress(void);
+float Uart1DmaGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,10 @@
 /**
  * @file Uart1DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart1TxInterruptHandler,
+ * or Uart1InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART1_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart1DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart1DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart1DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart1DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart1DmaRxDeinitialise(void);
 void Uart1DmaRxTasks(void);
+size_t Uart1DmaRxAvailableRead(void);
+size_t Uart1DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart1DmaRxReadByte(void);
+void Uart1DmaRxClearReadBuffer(void);
 size_t Uart1DmaRxAvailableWrite(void);
 FifoResult Uart1DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart1DmaRxWriteByte(const uint8_t byte);
 void Uart1DmaRxClearWriteBuffer(void);
+void Uart1DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart1DmaRxReceiveBufferOverrun(void);
 bool Uart1DmaRxTransmissionComplete(void);
+void Uart1DmaRxStartAutoBaud(void);
+bool Uart1DmaRxAutoBaudInProgress(void);
+float Uart1DmaRxGetBaudRate(void);
 
 #endif
 
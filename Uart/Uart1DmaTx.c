@@ -2,6 +2,7 @@
  * @file Uart1DmaTx.c
  * @author Seb Madgwick
  * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * Wrapper of UartDmaCore.
  */
 
 //------------------------------------------------------------------------------
@@ -9,25 +10,38 @@
 
 #include "Config.h"
 #include "definitions.h"
-#include "Fifo.h"
-#include "sys/kmem.h"
 #include "Uart1DmaTx.h"
+#include "UartDmaCore.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-static void WriteTransferComplete(void);
-static inline __attribute__((always_inline)) void RxInterruptTasks(void);
+static void TxDmaInterruptHandler(void);
 
 //------------------------------------------------------------------------------
 // Variables
 
-static bool receiveBufferOverrun;
 static uint8_t readData[UART1_READ_BUFFER_SIZE];
-static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
-static uint8_t writeData[UART1_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
-static void (*writeTransferComplete)(void);
+static uint8_t __attribute__((coherent)) writeData[UART1_WRITE_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#if UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE > 0
+static uint8_t __attribute__((coherent)) writeDataHighPriority[UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#endif
+static UartDmaCore uart = {
+    .registers = (UartRegisters*) &U1MODE,
+    .rxInterruptSource = INT_SOURCE_UART1_RX,
+    .txInterruptSource = INT_SOURCE_UART1_TX,
+    .rxIrq = _UART1_RX_VECTOR,
+    .txIrq = _UART1_TX_VECTOR,
+    .readMode = UartDmaReadModeInterrupt,
+    .writeDma = true,
+    .txDmaInterruptHandler = TxDmaInterruptHandler,
+    .readFifo = {.data = readData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (readData))},
+    .writeQueue = {.fifo = {.data = writeData, .dataSize = sizeof (writeData)}},
+#if UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE > 0
+    .writeQueueHighPriority = {.fifo = {.data = writeDataHighPriority, .dataSize = sizeof (writeDataHighPriority)}},
+#endif
+    .writeTransferSize = UART1_DMA_WRITE_TRANSFER_SIZE,
+};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -35,78 +49,18 @@ static void (*writeTransferComplete)(void);
 /**
  * @brief Initialises the module.
  * @param settings Settings.
+ * @return Result. UartResultError if the baud rate is zero or if the DMA
+ * channel could not be allocated.
  */
-void Uart1DmaTxInitialise(const UartSettings * const settings) {
-
-    // Ensure default register states
-    Uart1DmaTxDeinitialise();
-
-    // Configure UART
-    if (settings->rtsCtsEnabled) {
-        U1MODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-    }
-    if (settings->invertTxRx) {
-        U1MODEbits.RXINV = 1; // UxRX Idle state is '0'
-        U1STAbits.UTXINV = 1; // UxTX Idle state is '0'
-    }
-    U1MODEbits.PDSEL = settings->parityAndData;
-    U1MODEbits.STSEL = settings->stopBits;
-    U1MODEbits.BRGH = 1; // high-Speed mode - 4x baud clock enabled
-    U1STAbits.URXISEL = 0b01; // interrupt flag bit is asserted while receive buffer is 1/2 or more full (i.e., has 4 or more data characters)
-    U1STAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
-    U1STAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
-    U1BRG = UartCalculateUxbrg(settings->baudRate);
-    U1MODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
-
-    // Enable DMA
-    DMACONbits.ON = 1;
-
-    // Configure TX DMA channel
-    DCH0ECONbits.CHSIRQ = _UART1_TX_VECTOR; // channel transfer start IRQ
-    DCH0ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH0DSA = KVA_TO_PA(&U1TXREG); // destination address
-    DCH0DSIZ = 1; // destination size
-    DCH0CSIZ = 1; // transfers per event
-    DCH0INTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
-
-    // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_UART1_RX);
-    EVIC_SourceEnable(INT_SOURCE_DMA0);
+UartResult Uart1DmaTxInitialise(const UartSettings * const settings) {
+    return UartDmaCoreInitialise(&uart, settings, NULL, NULL);
 }
 
 /**
  * @brief Deinitialises the module.
  */
 void Uart1DmaTxDeinitialise(void) {
-
-    // Disable UART and restore default register states
-    U1MODE = 0;
-    U1STA = 0;
-
-    // Disable TX DMA channel and restore default register states
-    DCH0CON = 0;
-    DCH0ECON = 0;
-    DCH0INT = 0;
-    DCH0SSA = 0;
-    DCH0DSA = 0;
-    DCH0SSIZ = 0;
-    DCH0DSIZ = 0;
-    DCH0SPTR = 0;
-    DCH0DPTR = 0;
-    DCH0CSIZ = 0;
-    DCH0CPTR = 0;
-    DCH0DAT = 0;
-
-    // Disable interrupts
-    EVIC_SourceDisable(INT_SOURCE_UART1_RX);
-    EVIC_SourceDisable(INT_SOURCE_DMA0);
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_RX);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
-
-    // Clear buffers
-    receiveBufferOverrun = false;
-    Uart1DmaTxClearReadBuffer();
-    Uart1DmaTxClearWriteBuffer();
+    UartDmaCoreDeinitialise(&uart);
 }
 
 /**
@@ -114,21 +68,7 @@ void Uart1DmaTxDeinitialise(void) {
  * @return Number of bytes available in the read buffer.
  */
 size_t Uart1DmaTxAvailableRead(void) {
-
-    // Trigger RX interrupt if receive buffer not empty
-    if (U1STAbits.URXDA == 1) {
-        EVIC_SourceEnable(INT_SOURCE_UART1_RX);
-        EVIC_SourceStatusSet(INT_SOURCE_UART1_RX);
-    }
-
-    // Clear receive buffer overrun flag
-    if (U1STAbits.OERR == 1) {
-        U1STAbits.OERR = 0;
-        receiveBufferOverrun = true;
-    }
-
-    // Return number of bytes
-    return FifoAvailableRead(&readFifo);
+    return UartDmaCoreAvailableRead(&uart);
 }
 
 /**
@@ -138,8 +78,18 @@ size_t Uart1DmaTxAvailableRead(void) {
  * @return Number of bytes read.
  */
 size_t Uart1DmaTxRead(void* const destination, size_t numberOfBytes) {
-    Uart1DmaTxAvailableRead(); // process receive buffer
-    return FifoRead(&readFifo, destination, numberOfBytes);
+    return UartDmaCoreRead(&uart, destination, numberOfBytes);
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult Uart1DmaTxFind(const uint8_t byte, size_t * const offset) {
+    return UartDmaCoreFind(&uart, byte, offset);
 }
 
 /**
@@ -148,7 +98,7 @@ size_t Uart1DmaTxRead(void* const destination, size_t numberOfBytes) {
  * @return Byte.
  */
 uint8_t Uart1DmaTxReadByte(void) {
-    return FifoReadByte(&readFifo);
+    return UartDmaCoreReadByte(&uart);
 }
 
 /**
@@ -156,7 +106,7 @@ uint8_t Uart1DmaTxReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart1DmaTxAvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return UartDmaCoreAvailableWrite(&uart);
 }
 
 /**
@@ -166,22 +116,61 @@ size_t Uart1DmaTxAvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart1DmaTxWrite(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
-    if (Uart1DmaTxWriteTransferInProgress() == false) {
-        WriteTransferComplete();
-    }
-    return result;
+    return UartDmaCoreWrite(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart1DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartDmaCoreWritev(&uart, vectors, numberOfVectors);
+}
+
+/**
+ * @brief Writes a break character to the write buffer. The UART transmits the
+ * break in place of a dummy byte written by this function. The transmitter
+ * must be idle.
+ * @return Result.
+ */
+FifoResult Uart1DmaTxWriteBreak(void) {
+    return UartDmaCoreWriteBreak(&uart);
+}
+
+/**
+ * @brief Returns the space available in the high-priority write buffer.
+ * @return Space available in the high-priority write buffer.
+ */
+size_t Uart1DmaTxAvailableWriteHighPriority(void) {
+    return UartDmaCoreAvailableWriteHighPriority(&uart);
+}
+
+/**
+ * @brief Writes data to the high-priority write buffer. Data in the
+ * high-priority write buffer is transferred before data in the write buffer,
+ * starting from the next transfer. Not available if
+ * UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE is 0.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult Uart1DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes) {
+    return UartDmaCoreWriteHighPriority(&uart, data, numberOfBytes);
 }
 
 /**
- * @brief Write transfer complete callback.
+ * @brief Writes a vector of data to the high-priority write buffer. Either all
+ * or none of the data will be written. Not available if
+ * UART1_DMA_HIGH_PRIORITY_BUFFER_SIZE is 0.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
  */
-static void WriteTransferComplete(void) {
-    static __attribute__((coherent)) uint8_t data[UART1_DMA_WRITE_TRANSFER_SIZE];
-    const size_t numberOfBytes = FifoRead(&writeFifo, data, sizeof (data));
-    if (numberOfBytes > 0) {
-        Uart1DmaTxWriteTransfer(data, numberOfBytes, WriteTransferComplete);
-    }
+FifoResult Uart1DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartDmaCoreWritevHighPriority(&uart, vectors, numberOfVectors);
 }
 
 /**
@@ -194,22 +183,7 @@ static void WriteTransferComplete(void) {
  * unused.
  */
 void Uart1DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void)) {
-    writeTransferComplete = writeTransferComplete_;
-    DCH0SSA = KVA_TO_PA(data); // source address
-    DCH0SSIZ = numberOfBytes; // source size
-    DCH0INTbits.CHBCIF = 0; // clear TX DMA channel interrupt flag
-    DCH0CONbits.CHEN = 1; // enable TX DMA channel to begin write
-}
-
-/**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
- */
-void Dma0InterruptHandler(void) {
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0); // clear interrupt flag first because callback may start new write
-    if (writeTransferComplete != NULL) {
-        writeTransferComplete();
-    }
+    UartDmaCoreWriteTransfer(&uart, data, numberOfBytes, writeTransferComplete_);
 }
 
 /**
@@ -217,22 +191,31 @@ void Dma0InterruptHandler(void) {
  * @return True while data is being transferred to the transmit buffer.
  */
 bool Uart1DmaTxWriteTransferInProgress(void) {
-    return DCH0CONbits.CHEN == 1;
+    return UartDmaCoreWriteTransferInProgress(&uart);
 }
 
 /**
  * @brief Clears the read buffer and resets the read buffer overrun flag.
  */
 void Uart1DmaTxClearReadBuffer(void) {
-    FifoClear(&readFifo);
-    Uart1DmaTxReceiveBufferOverrun(); // clear flag
+    UartDmaCoreClearReadBuffer(&uart);
 }
 
 /**
  * @brief Clears the write buffer.
  */
 void Uart1DmaTxClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    UartDmaCoreClearWriteBuffer(&uart);
+}
+
+/**
+ * @brief Gets the write statistics. The maximum values are reset each time
+ * this function is called.
+ * @param statistics Write buffer statistics.
+ * @param highPriorityStatistics High-priority write buffer statistics.
+ */
+void Uart1DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics) {
+    UartDmaCoreGetWriteStatistics(&uart, statistics, highPriorityStatistics);
 }
 
 /**
@@ -241,11 +224,7 @@ void Uart1DmaTxClearWriteBuffer(void) {
  * @return True if the receive buffer has overrun.
  */
 bool Uart1DmaTxReceiveBufferOverrun(void) {
-    if (receiveBufferOverrun) {
-        receiveBufferOverrun = false;
-        return true;
-    }
-    return false;
+    return UartDmaCoreReceiveBufferOverrun(&uart);
 }
 
 /**
@@ -253,7 +232,41 @@ bool Uart1DmaTxReceiveBufferOverrun(void) {
  * @return True if all data has been transmitted.
  */
 bool Uart1DmaTxTransmissionComplete(void) {
-    return (Uart1DmaTxWriteTransferInProgress() == false) && (U1STAbits.TRMT == 1);
+    return UartDmaCoreTransmissionComplete(&uart);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ */
+void Uart1DmaTxStartAutoBaud(void) {
+    UartDmaCoreStartAutoBaud(&uart);
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @return True while auto-baud is in progress.
+ */
+bool Uart1DmaTxAutoBaudInProgress(void) {
+    return UartDmaCoreAutoBaudInProgress(&uart);
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @return Baud rate.
+ */
+float Uart1DmaTxGetBaudRate(void) {
+    return UartDmaCoreGetBaudRate(&uart);
+}
+
+/**
+ * @brief TX DMA channel interrupt handler.
+ */
+static void TxDmaInterruptHandler(void) {
+    UartDmaCoreTxDmaInterruptHandler(&uart);
 }
 
 #ifdef _UART_1_VECTOR
@@ -263,9 +276,7 @@ bool Uart1DmaTxTransmissionComplete(void) {
  * the ISR implementation generated by MPLAB Harmony.
  */
 void Uart1InterruptHandler(void) {
-    if (EVIC_SourceStatusGet(INT_SOURCE_UART1_RX)) {
-        RxInterruptTasks();
-    }
+    UartDmaCoreInterruptHandler(&uart);
 }
 
 #else
@@ -275,24 +286,19 @@ void Uart1InterruptHandler(void) {
  * implementation generated by MPLAB Harmony.
  */
 void Uart1RxInterruptHandler(void) {
-    RxInterruptTasks();
+    UartDmaCoreRxInterruptHandler(&uart);
 }
 
-#endif
-
 /**
- * @brief UART RX interrupt tasks.
+ * @brief UART TX interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony. Only required if the RS-485
+ * driver enable is used.
  */
-static inline __attribute__((always_inline)) void RxInterruptTasks(void) {
-    while (U1STAbits.URXDA == 1) { // while data available in receive buffer
-        if (FifoAvailableWrite(&readFifo) == 0) { // if read buffer full
-            EVIC_SourceDisable(INT_SOURCE_UART1_RX);
-            break;
-        }
-        FifoWriteByte(&readFifo, U1RXREG);
-    }
-    EVIC_SourceStatusClear(INT_SOURCE_UART1_RX);
+void Uart1TxInterruptHandler(void) {
+    UartDmaCoreTxInterruptHandler(&uart);
 }
 
+#endif
+
 //------------------------------------------------------------------------------
 // End of file
@@ -1,7 +1,11 @@
 /**
  * @file Uart1DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart1RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart1TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart1InterruptHandler instead.
  */
 
 #ifndef UART1_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart1DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart1DmaTxInitialise(const UartSettings * const settings);
 void Uart1DmaTxDeinitialise(void);
 size_t Uart1DmaTxAvailableRead(void);
 size_t Uart1DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart1DmaTxReadByte(void);
+FifoResult Uart1DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart1DmaTxAvailableWrite(void);
 FifoResult Uart1DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart1DmaTxWriteBreak(void);
+size_t Uart1DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart1DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart1DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart1DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart1DmaTxWriteTransferInProgress(void);
 void Uart1DmaTxClearReadBuffer(void);
 void Uart1DmaTxClearWriteBuffer(void);
+void Uart1DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart1DmaTxReceiveBufferOverrun(void);
 bool Uart1DmaTxTransmissionComplete(void);
+void Uart1DmaTxStartAutoBaud(void);
+bool Uart1DmaTxAutoBaudInProgress(void);
+float Uart1DmaTxGetBaudRate(void);
 
 #endif
 
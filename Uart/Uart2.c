@@ -1,7 +1,7 @@
 /**
  * @file Uart2.c
  * @author Seb Madgwick
- * @brief UART driver for PIC32 devices.
+ * @brief UART driver for PIC32 devices. Wrapper of UartCore.
  */
 
 //------------------------------------------------------------------------------
@@ -10,21 +10,20 @@
 #include "Config.h"
 #include "definitions.h"
 #include "Uart2.h"
-
-//------------------------------------------------------------------------------
-// Function declarations
-
-static inline __attribute__((always_inline)) void RxInterruptTasks(void);
-static inline __attribute__((always_inline)) void TxInterruptTasks(void);
+#include "UartCore.h"
 
 //------------------------------------------------------------------------------
 // Variables
 
-static bool receiveBufferOverrun;
 static uint8_t readData[UART2_READ_BUFFER_SIZE];
-static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
 static uint8_t writeData[UART2_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+static UartCore uart = {
+    .registers = (UartRegisters*) &U2MODE,
+    .rxInterruptSource = INT_SOURCE_UART2_RX,
+    .txInterruptSource = INT_SOURCE_UART2_TX,
+    .readFifo = {.data = readData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (readData))},
+    .writeFifo = {.data = writeData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (writeData))},
+};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -32,53 +31,25 @@ static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
 /**
  * @brief Initialises the module.
  * @param settings Settings.
+ * @return Result. UartResultError if the baud rate is zero.
  */
-void Uart2Initialise(const UartSettings * const settings) {
-
-    // Ensure default register states
-    Uart2Deinitialise();
-
-    // Configure UART
-    if (settings->rtsCtsEnabled) {
-        U2MODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-    }
-    if (settings->invertTxRx) {
-        U2MODEbits.RXINV = 1; // UxRX Idle state is '0'
-        U2STAbits.UTXINV = 1; // UxTX Idle state is '0'
-    }
-    U2MODEbits.PDSEL = settings->parityAndData;
-    U2MODEbits.STSEL = settings->stopBits;
-    U2MODEbits.BRGH = 1; // high-Speed mode - 4x baud clock enabled
-    U2STAbits.URXISEL = 0b01; // interrupt flag bit is asserted while receive buffer is 1/2 or more full (i.e., has 4 or more data characters)
-    U2STAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
-    U2STAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
-    U2STAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
-    U2BRG = UartCalculateUxbrg(settings->baudRate);
-    U2MODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
-
-    // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_UART2_RX);
+UartResult Uart2Initialise(const UartSettings * const settings) {
+    return UartCoreInitialise(&uart, settings);
 }
 
 /**
  * @brief Deinitialises the module.
  */
 void Uart2Deinitialise(void) {
+    UartCoreDeinitialise(&uart);
+}
 
-    // Disable UART and restore default register states
-    U2MODE = 0;
-    U2STA = 0;
-
-    // Disable interrupts
-    EVIC_SourceDisable(INT_SOURCE_UART2_RX);
-    EVIC_SourceDisable(INT_SOURCE_UART2_TX);
-    EVIC_SourceStatusClear(INT_SOURCE_UART2_RX);
-    EVIC_SourceStatusClear(INT_SOURCE_UART2_TX);
-
-    // Clear buffers
-    receiveBufferOverrun = false;
-    Uart2ClearReadBuffer();
-    Uart2ClearWriteBuffer();
+/**
+ * @brief Module tasks. This function should be called repeatedly within the
+ * main program loop if the adaptive RX interrupt threshold is enabled.
+ */
+void Uart2Tasks(void) {
+    UartCoreTasks(&uart);
 }
 
 /**
@@ -86,21 +57,7 @@ void Uart2Deinitialise(void) {
  * @return Number of bytes available in the read buffer.
  */
 size_t Uart2AvailableRead(void) {
-
-    // Trigger RX interrupt if receive buffer not empty
-    if (U2STAbits.URXDA == 1) {
-        EVIC_SourceEnable(INT_SOURCE_UART2_RX);
-        EVIC_SourceStatusSet(INT_SOURCE_UART2_RX);
-    }
-
-    // Clear receive buffer overrun flag
-    if (U2STAbits.OERR == 1) {
-        U2STAbits.OERR = 0;
-        receiveBufferOverrun = true;
-    }
-
-    // Return number of bytes
-    return FifoAvailableRead(&readFifo);
+    return UartCoreAvailableRead(&uart);
 }
 
 /**
@@ -110,8 +67,18 @@ size_t Uart2AvailableRead(void) {
  * @return Number of bytes read.
  */
 size_t Uart2Read(void* const destination, size_t numberOfBytes) {
-    Uart2AvailableRead(); // process receive buffer
-    return FifoRead(&readFifo, destination, numberOfBytes);
+    return UartCoreRead(&uart, destination, numberOfBytes);
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult Uart2Find(const uint8_t byte, size_t * const offset) {
+    return UartCoreFind(&uart, byte, offset);
 }
 
 /**
@@ -120,7 +87,7 @@ size_t Uart2Read(void* const destination, size_t numberOfBytes) {
  * @return Byte.
  */
 uint8_t Uart2ReadByte(void) {
-    return FifoReadByte(&readFifo);
+    return UartCoreReadByte(&uart);
 }
 
 /**
@@ -128,7 +95,7 @@ uint8_t Uart2ReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart2AvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return UartCoreAvailableWrite(&uart);
 }
 
 /**
@@ -138,9 +105,18 @@ size_t Uart2AvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart2Write(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
-    EVIC_SourceEnable(INT_SOURCE_UART2_TX);
-    return result;
+    return UartCoreWrite(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart2Writev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartCoreWritev(&uart, vectors, numberOfVectors);
 }
 
 /**
@@ -149,24 +125,21 @@ FifoResult Uart2Write(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult Uart2WriteByte(const uint8_t byte) {
-    const FifoResult result = FifoWriteByte(&writeFifo, byte);
-    EVIC_SourceEnable(INT_SOURCE_UART2_TX);
-    return result;
+    return UartCoreWriteByte(&uart, byte);
 }
 
 /**
  * @brief Clears the read buffer and resets the read buffer overrun flag.
  */
 void Uart2ClearReadBuffer(void) {
-    FifoClear(&readFifo);
-    Uart2ReceiveBufferOverrun(); // clear flag
+    UartCoreClearReadBuffer(&uart);
 }
 
 /**
  * @brief Clears the write buffer.
  */
 void Uart2ClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    UartCoreClearWriteBuffer(&uart);
 }
 
 /**
@@ -175,11 +148,7 @@ void Uart2ClearWriteBuffer(void) {
  * @return True if the receive buffer has overrun.
  */
 bool Uart2ReceiveBufferOverrun(void) {
-    if (receiveBufferOverrun) {
-        receiveBufferOverrun = false;
-        return true;
-    }
-    return false;
+    return UartCoreReceiveBufferOverrun(&uart);
 }
 
 /**
@@ -187,7 +156,43 @@ bool Uart2ReceiveBufferOverrun(void) {
  * @return True if all data has been transmitted.
  */
 bool Uart2TransmissionComplete(void) {
-    return (EVIC_SourceIsEnabled(INT_SOURCE_UART2_TX) == false) && (U2STAbits.TRMT == 1);
+    return UartCoreTransmissionComplete(&uart);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ */
+void Uart2StartAutoBaud(void) {
+    UartCoreStartAutoBaud(&uart);
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @return True while auto-baud is in progress.
+ */
+bool Uart2AutoBaudInProgress(void) {
+    return UartCoreAutoBaudInProgress(&uart);
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @return Baud rate.
+ */
+float Uart2GetBaudRate(void) {
+    return UartCoreGetBaudRate(&uart);
+}
+
+/**
+ * @brief Gets the statistics. Rates are calculated from the counts since the
+ * previous call.
+ * @param statistics Statistics.
+ */
+void Uart2GetStatistics(UartStatistics * const statistics) {
+    UartCoreGetStatistics(&uart, statistics);
 }
 
 #ifdef _UART_2_VECTOR
@@ -197,19 +202,7 @@ bool Uart2TransmissionComplete(void) {
  * the ISR implementation generated by MPLAB Harmony.
  */
 void Uart2InterruptHandler(void) {
-
-    // RX interrupt
-    if (EVIC_SourceStatusGet(INT_SOURCE_UART2_RX)) {
-        RxInterruptTasks();
-    }
-
-    // TX interrupt
-    if (EVIC_SourceIsEnabled(INT_SOURCE_UART2_TX) == false) {
-        return; // return if TX interrupt disabled because TX interrupt flag will remain set while the transmit buffer is empty
-    }
-    if (EVIC_SourceStatusGet(INT_SOURCE_UART2_TX)) {
-        TxInterruptTasks();
-    }
+    UartCoreInterruptHandler(&uart);
 }
 
 #else
@@ -219,7 +212,7 @@ void Uart2InterruptHandler(void) {
  * implementation generated by MPLAB Harmony.
  */
 void Uart2RxInterruptHandler(void) {
-    RxInterruptTasks();
+    UartCoreRxInterruptHandler(&uart);
 }
 
 /**
@@ -227,39 +220,10 @@ void Uart2RxInterruptHandler(void) {
  * implementation generated by MPLAB Harmony.
  */
 void Uart2TxInterruptHandler(void) {
-    TxInterruptTasks();
+    UartCoreTxInterruptHandler(&uart);
 }
 
 #endif
 
-/**
- * @brief UART RX interrupt tasks.
- */
-static inline __attribute__((always_inline)) void RxInterruptTasks(void) {
-    while (U2STAbits.URXDA == 1) { // while data available in receive buffer
-        if (FifoAvailableWrite(&readFifo) == 0) { // if read buffer full
-            EVIC_SourceDisable(INT_SOURCE_UART2_RX);
-            break;
-        }
-        FifoWriteByte(&readFifo, U2RXREG);
-    }
-    EVIC_SourceStatusClear(INT_SOURCE_UART2_RX);
-}
-
-/**
- * @brief UART TX interrupt tasks.
- */
-static inline __attribute__((always_inline)) void TxInterruptTasks(void) {
-    EVIC_SourceDisable(INT_SOURCE_UART2_TX); // disable TX interrupt to avoid nested interrupt
-    EVIC_SourceStatusClear(INT_SOURCE_UART2_TX);
-    while (U2STAbits.UTXBF == 0) { // while transmit buffer not full
-        if (FifoAvailableRead(&writeFifo) == 0) { // if write buffer empty
-            return;
-        }
-        U2TXREG = FifoReadByte(&writeFifo);
-    }
-    EVIC_SourceEnable(INT_SOURCE_UART2_TX); // re-enable TX interrupt
-}
-
 //------------------------------------------------------------------------------
 // End of file
@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart2Initialise(const UartSettings * const settings);
+UartResult Uart2Initialise(const UartSettings * const settings);
 void Uart2Deinitialise(void);
+void Uart2Tasks(void);
 size_t Uart2AvailableRead(void);
 size_t Uart2Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart2ReadByte(void);
+FifoResult Uart2Find(const uint8_t byte, size_t * const offset);
 size_t Uart2AvailableWrite(void);
 FifoResult Uart2Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart2WriteByte(const uint8_t byte);
 void Uart2ClearReadBuffer(void);
 void Uart2ClearWriteBuffer(void);
 bool Uart2ReceiveBufferOverrun(void);
 bool Uart2TransmissionComplete(void);
+void Uart2StartAutoBaud(void);
+bool Uart2AutoBaudInProgress(void);
+float Uart2GetBaudRate(void);
+void Uart2GetStatistics(UartStatistics * const statistics);
 
 #endif
 
@@ -1,7 +1,10 @@
 /**
  * @file Uart2Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart2TxInterruptHandler, or
+ * Uart2InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART2_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart2DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart2DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart2DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart2DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart2DmaDeinitialise(void);
 void Uart2DmaTasks(void);
+size_t Uart2DmaAvailableRead(void);
+size_t Uart2DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart2DmaReadByte(void);
+void Uart2DmaClearReadBuffer(void);
 size_t Uart2DmaAvailableWrite(void);
 FifoResult Uart2DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart2DmaWriteBreak(void);
+size_t Uart2DmaAvailableWriteHighPriority(void);
+FifoResult Uart2DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart2DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart2DmaWriteTransferInProgress(void);
 void Uart2DmaClearWriteBuffer(void);
+void Uart2DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart2DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart2DmaReceiveBufferOverrun(void);
 bool Uart2DmaTransmissionComplete(void);
+void Uart2DmaStartAutoBaud(void);
+bool Uart2DmaAutoBaudInProgress(void);
+float Uart2DmaGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,10 @@
 /**
  * @file Uart2DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart2TxInterruptHandler,
+ * or Uart2InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART2_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart2DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart2DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart2DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart2DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart2DmaRxDeinitialise(void);
 void Uart2DmaRxTasks(void);
+size_t Uart2DmaRxAvailableRead(void);
+size_t Uart2DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart2DmaRxReadByte(void);
+void Uart2DmaRxClearReadBuffer(void);
 size_t Uart2DmaRxAvailableWrite(void);
 FifoResult Uart2DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart2DmaRxWriteByte(const uint8_t byte);
 void Uart2DmaRxClearWriteBuffer(void);
+void Uart2DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart2DmaRxReceiveBufferOverrun(void);
 bool Uart2DmaRxTransmissionComplete(void);
+void Uart2DmaRxStartAutoBaud(void);
+bool Uart2DmaRxAutoBaudInProgress(void);
+float Uart2DmaRxGetBaudRate(void);
 
 #endif
 
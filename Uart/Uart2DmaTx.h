@@ -1,7 +1,11 @@
 /**
  * @file Uart2DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart2RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart2TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart2InterruptHandler instead.
  */
 
 #ifndef UART2_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart2DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart2DmaTxInitialise(const UartSettings * const settings);
 void Uart2DmaTxDeinitialise(void);
 size_t Uart2DmaTxAvailableRead(void);
 size_t Uart2DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart2DmaTxReadByte(void);
+FifoResult Uart2DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart2DmaTxAvailableWrite(void);
 FifoResult Uart2DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart2DmaTxWriteBreak(void);
+size_t Uart2DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart2DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart2DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart2DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart2DmaTxWriteTransferInProgress(void);
 void Uart2DmaTxClearReadBuffer(void);
 void Uart2DmaTxClearWriteBuffer(void);
+void Uart2DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart2DmaTxReceiveBufferOverrun(void);
 bool Uart2DmaTxTransmissionComplete(void);
+void Uart2DmaTxStartAutoBaud(void);
+bool Uart2DmaTxAutoBaudInProgress(void);
+float Uart2DmaTxGetBaudRate(void);
 
 #endif
 
@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart3Initialise(const UartSettings * const settings);
+UartResult Uart3Initialise(const UartSettings * const settings);
 void Uart3Deinitialise(void);
+void Uart3Tasks(void);
 size_t Uart3AvailableRead(void);
 size_t Uart3Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart3ReadByte(void);
+FifoResult Uart3Find(const uint8_t byte, size_t * const offset);
 size_t Uart3AvailableWrite(void);
 FifoResult Uart3Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart3WriteByte(const uint8_t byte);
 void Uart3ClearReadBuffer(void);
 void Uart3ClearWriteBuffer(void);
 bool Uart3ReceiveBufferOverrun(void);
 bool Uart3TransmissionComplete(void);
+void Uart3StartAutoBaud(void);
+bool Uart3AutoBaudInProgress(void);
+float Uart3GetBaudRate(void);
+void Uart3GetStatistics(UartStatistics * const statistics);
 
 #endif
 
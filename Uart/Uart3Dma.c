@@ -1,7 +1,7 @@
 /**
  * @file Uart3Dma.c
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. Wrapper of UartDmaCore.
  */
 
 //------------------------------------------------------------------------------
@@ -9,31 +9,77 @@
 
 #include "Config.h"
 #include "definitions.h"
-#include <stdint.h>
-#include "sys/kmem.h"
-#include "Timer/Timer.h"
 #include "Uart3Dma.h"
+#include "UartDmaCore.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#if defined UART3_DMA_PING_PONG && defined UART3_DMA_READ_STREAM
+#error "UART3_DMA_PING_PONG cannot be used with UART3_DMA_READ_STREAM."
+#endif
+
+#if defined UART3_DMA_READ_DEFERRED && defined UART3_DMA_READ_STREAM
+#error "UART3_DMA_READ_DEFERRED cannot be used with UART3_DMA_READ_STREAM."
+#endif
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-static void WriteTransferComplete(void);
-static inline __attribute__((always_inline)) void BlockTransferComplete(void);
-static inline __attribute__((always_inline)) void TransferAborted(void);
+static void RxDmaInterruptHandler(void);
+static void TxDmaInterruptHandler(void);
 
 //------------------------------------------------------------------------------
 // Variables
 
+#if defined UART3_DMA_READ_STREAM
+static uint8_t __attribute__((coherent)) readData[UART3_READ_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#elif defined UART3_DMA_PING_PONG || defined UART3_DMA_READ_DEFERRED
+static uint8_t __attribute__((coherent)) readDataPing[UART3_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+static uint8_t __attribute__((coherent)) readDataPong[UART3_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#else
+static uint8_t __attribute__((coherent)) readData[UART3_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#endif
+static uint32_t __attribute__((coherent)) timerReset[1]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+static uint8_t __attribute__((coherent)) writeData[UART3_WRITE_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#if UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE > 0
+static uint8_t __attribute__((coherent)) writeDataHighPriority[UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#endif
+static UartDmaCore uart = {
+    .registers = (UartRegisters*) &U3MODE,
+    .rxInterruptSource = INT_SOURCE_UART3_RX,
+    .txInterruptSource = INT_SOURCE_UART3_TX,
+    .rxIrq = _UART3_RX_VECTOR,
+    .txIrq = _UART3_TX_VECTOR,
+#if defined UART3_DMA_READ_STREAM
+    .readMode = UartDmaReadModeStream,
+    .readStream = {.data = readData, .dataSize = sizeof (readData)},
+#elif defined UART3_DMA_READ_DEFERRED
+    .readMode = UartDmaReadModeDeferred,
+    .readDataPing = readDataPing,
+    .readDataPong = readDataPong,
+#elif defined UART3_DMA_PING_PONG
+    .readMode = UartDmaReadModePingPong,
+    .readDataPing = readDataPing,
+    .readDataPong = readDataPong,
+#else
+    .readMode = UartDmaReadModeBlock,
+    .readDataPing = readData,
+#endif
 #ifdef UART3_DMA_TIMEOUT_POLL
-static uint64_t readTimeoutTicks;
-static uint64_t readTimeoutExpiry;
+    .readTimeoutPoll = true,
 #endif
-static bool receiveBufferOverrun;
-static void (*read)(const void* const data, const size_t numberOfBytes);
-static uint8_t __attribute__((coherent)) readData[UART3_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-static uint8_t writeData[UART3_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
-static void (*writeTransferComplete)(void);
+    .writeDma = true,
+    .rxDmaInterruptHandler = RxDmaInterruptHandler,
+    .txDmaInterruptHandler = TxDmaInterruptHandler,
+    .readTransferSize = UART3_DMA_READ_TRANSFER_SIZE,
+    .timerReset = timerReset,
+    .writeQueue = {.fifo = {.data = writeData, .dataSize = sizeof (writeData)}},
+#if UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE > 0
+    .writeQueueHighPriority = {.fifo = {.data = writeDataHighPriority, .dataSize = sizeof (writeDataHighPriority)}},
+#endif
+    .writeTransferSize = UART3_DMA_WRITE_TRANSFER_SIZE,
+};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -43,157 +89,46 @@ static void (*writeTransferComplete)(void);
  * @param settings Settings.
  * @param readConditions Read conditions.
  * @param read Read callback. NULL if unused.
+ * @return Result. UartResultError if the baud rate is zero or if the DMA
+ * channels or read timeout timer could not be allocated.
  */
-void Uart3DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes)) {
-
-    // Ensure default register states
-    Uart3DmaDeinitialise();
-
-    // Configure UART
-    if (settings->rtsCtsEnabled) {
-        U3MODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-    }
-    if (settings->invertTxRx) {
-        U3MODEbits.RXINV = 1; // UxRX Idle state is '0'
-        U3STAbits.UTXINV = 1; // UxTX Idle state is '0'
-    }
-    U3MODEbits.PDSEL = settings->parityAndData;
-    U3MODEbits.STSEL = settings->stopBits;
-    U3MODEbits.BRGH = 1; // high-Speed mode - 4x baud clock enabled
-    U3STAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
-    U3STAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
-    U3BRG = UartCalculateUxbrg(settings->baudRate);
-    U3MODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
-
-    // Store read arguments
-#ifdef UART3_DMA_TIMEOUT_POLL
-    readTimeoutTicks = (uint64_t) readConditions->timeout * TIMER_TICKS_PER_MILLISECOND;
-#endif
-    read = read_;
-
-    // Enable DMA
-    DMACONbits.ON = 1;
-
-    // Configure TX DMA channel
-    DCH0ECONbits.CHSIRQ = _UART3_TX_VECTOR; // channel transfer start IRQ
-    DCH0ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH0DSA = KVA_TO_PA(&U3TXREG); // destination address
-    DCH0DSIZ = 1; // destination size
-    DCH0CSIZ = 1; // transfers per event
-    DCH0INTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
-
-    // Configure RX DMA channel
-#ifndef UART3_DMA_TIMEOUT_POLL
-    DCH1ECONbits.CHAIRQ = _TIMER_9_VECTOR; // channel transfer abort IRQ
-    DCH1ECONbits.AIRQEN = 1; // channel transfer is aborted if an interrupt matching CHAIRQ occurs
-#endif
-    DCH1ECONbits.CHSIRQ = _UART3_RX_VECTOR; // channel transfer start IRQ
-    DCH1ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    if (readConditions->termination != -1) {
-        DCH1ECONbits.PATEN = 1; // abort transfer and clear CHEN on pattern match
-    }
-    DCH1SSA = KVA_TO_PA(&U3RXREG); // source address
-    DCH1DSA = KVA_TO_PA(readData); // destination address
-    DCH1SSIZ = 1; // source size
-    DCH1DSIZ = readConditions->numberOfBytes > sizeof (readData) ? sizeof (readData) : readConditions->numberOfBytes; // destination size
-    DCH1CSIZ = 1; // transfers per event
-    DCH1DAT = readConditions->termination & 0xFF; // pattern data
-    DCH1INTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
-    DCH1INTbits.CHTAIE = 1; // channel transfer abort interrupt enable bit
-    DCH1CONbits.CHEN = 1; // channel is enabled
-
-    // Calculate timer reset value
-#ifndef UART3_DMA_TIMEOUT_POLL
-    static uint32_t __attribute__((coherent)) timerReset[1]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-    timerReset[0] = UartDmaCalculateTimerReset(readConditions->timeout);
-
-    // Configure timer DMA channel
-    DCH2CONbits.CHAEN = 1; // channel is continuously enabled, and not automatically disabled after a block transfer is complete
-    DCH2ECONbits.CHSIRQ = _UART3_RX_VECTOR; // channel transfer start IRQ
-    DCH2ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH2SSA = KVA_TO_PA(timerReset); // source address
-    DCH2DSA = KVA_TO_PA(&TMR8); // destination address
-    DCH2SSIZ = sizeof (timerReset); // source size
-    DCH2DSIZ = sizeof (timerReset); // destination size
-    DCH2CSIZ = sizeof (timerReset); // transfers per event
-    DCH2CONbits.CHEN = 1; // channel is enabled
-
-    // Configure timer
-    T8CONbits.T32 = 1;
-    T8CONbits.ON = 1;
-#endif
+UartResult Uart3DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes)) {
+    return UartDmaCoreInitialise(&uart, settings, readConditions, read_);
+}
 
-    // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_DMA0);
-    EVIC_SourceEnable(INT_SOURCE_DMA1);
+/**
+ * @brief Initialises the module with a read callback that also receives the
+ * time of the first byte and the time of completion of each read. The first
+ * byte is timestamped by the RX DMA channel cell transfer complete interrupt.
+ * Timestamps are not available if UART3_DMA_READ_STREAM is defined.
+ * @param settings Settings.
+ * @param readConditions Read conditions.
+ * @param readTimestamped Read callback.
+ * @return Result.
+ */
+UartResult Uart3DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps)) {
+    return UartDmaCoreInitialiseTimestamped(&uart, settings, readConditions, readTimestamped_);
+}
+
+/**
+ * @brief Sets the bridge that each read is forwarded to from Uart3DmaTasks.
+ * The read callback may be used as a tap. Data is transferred directly from
+ * the read buffer if the bridge provides a write transfer function that is not
+ * in progress. Otherwise, data is written to the bridge write buffer. The read
+ * buffer is not reused until the transfer is complete. This function must be
+ * called after initialisation. The bridge is only available if
+ * UART3_DMA_READ_DEFERRED is defined.
+ * @param bridge_ Bridge. NULL to disable.
+ */
+void Uart3DmaSetBridge(const UartDmaBridge * const bridge_) {
+    UartDmaCoreSetBridge(&uart, bridge_);
 }
 
 /**
  * @brief Deinitialises the module.
  */
 void Uart3DmaDeinitialise(void) {
-
-    // Disable UART and restore default register states
-    U3MODE = 0;
-    U3STA = 0;
-
-    // Disable TX DMA channel and restore default register states
-    DCH0CON = 0;
-    DCH0ECON = 0;
-    DCH0INT = 0;
-    DCH0SSA = 0;
-    DCH0DSA = 0;
-    DCH0SSIZ = 0;
-    DCH0DSIZ = 0;
-    DCH0SPTR = 0;
-    DCH0DPTR = 0;
-    DCH0CSIZ = 0;
-    DCH0CPTR = 0;
-    DCH0DAT = 0;
-
-    // Disable RX DMA channel and restore default register states
-    DCH1CON = 0;
-    DCH1ECON = 0;
-    DCH1INT = 0;
-    DCH1SSA = 0;
-    DCH1DSA = 0;
-    DCH1SSIZ = 0;
-    DCH1DSIZ = 0;
-    DCH1SPTR = 0;
-    DCH1DPTR = 0;
-    DCH1CSIZ = 0;
-    DCH1CPTR = 0;
-    DCH1DAT = 0;
-
-    // Disable timer DMA channel and restore default register states
-#ifndef UART3_DMA_TIMEOUT_POLL
-    DCH2CON = 0;
-    DCH2ECON = 0;
-    DCH2INT = 0;
-    DCH2SSA = 0;
-    DCH2DSA = 0;
-    DCH2SSIZ = 0;
-    DCH2DSIZ = 0;
-    DCH2SPTR = 0;
-    DCH2DPTR = 0;
-    DCH2CSIZ = 0;
-    DCH2CPTR = 0;
-    DCH2DAT = 0;
-
-    // Disable timer and restore default register states
-    T8CON = 0;
-    T9CON = 0;
-#endif
-
-    // Disable interrupts
-    EVIC_SourceDisable(INT_SOURCE_DMA0);
-    EVIC_SourceDisable(INT_SOURCE_DMA1);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
-
-    // Clear buffer
-    receiveBufferOverrun = false;
-    Uart3DmaClearWriteBuffer();
+    UartDmaCoreDeinitialise(&uart);
 }
 
 /**
@@ -201,95 +136,47 @@ void Uart3DmaDeinitialise(void) {
  * main program loop.
  */
 void Uart3DmaTasks(void) {
+    UartDmaCoreTasks(&uart);
+}
 
-    // Clear receive buffer overrun flag
-    if (U3STAbits.OERR == 1) {
-        U3STAbits.OERR = 0;
-        receiveBufferOverrun = true;
-    }
-
-    // Do nothing else if no data available
-#ifdef UART3_DMA_TIMEOUT_POLL
-    const size_t available = DCH1DPTR;
-    static size_t previous;
-    if (available == 0) {
-        previous = 0;
-        return;
-    }
-
-    // Reset timeout if new data received
-    if (available != previous) {
-        readTimeoutExpiry = TimerGetTicks64() + readTimeoutTicks;
-        previous = available;
-        return;
-    }
-
-    // Wait for timeout
-    if (TimerGetTicks64() < readTimeoutExpiry) {
-        return;
-    }
-
-    // Read
-    DCH1INTbits.CHTAIF = 1; // trigger transfer abort interrupt
-    previous = 0;
-#endif
+/**
+ * @brief Returns the number of bytes available in the read buffer. The DMA
+ * channel writes to the read buffer continuously so data will be lost if the
+ * read buffer is not read before it is full. Only available if
+ * UART3_DMA_READ_STREAM is defined.
+ * @return Number of bytes available in the read buffer.
+ */
+size_t Uart3DmaAvailableRead(void) {
+    return UartDmaCoreAvailableRead(&uart);
 }
 
 /**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
+ * @brief Reads data from the read buffer. Only available if
+ * UART3_DMA_READ_STREAM is defined.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
  */
-void Dma1InterruptHandler(void) {
-
-    // Block transfer complete
-    if (DCH1INTbits.CHBCIF == 1) {
-        BlockTransferComplete();
-        DCH1INTbits.CHBCIF = 0;
-    }
-
-    // Transfer aborted
-    if (DCH1INTbits.CHTAIF == 1) {
-        TransferAborted();
-        DCH1INTbits.CHTAIF = 0;
-    }
-
-    // Re-enable channel
-    EVIC_SourceStatusClear(INT_SOURCE_DMA1);
-    DCH1CONbits.CHEN = 1;
+size_t Uart3DmaRead(void* const destination, size_t numberOfBytes) {
+    return UartDmaCoreRead(&uart, destination, numberOfBytes);
 }
 
 /**
- * @brief Block transfer complete.
+ * @brief Reads a byte from the read buffer. This function must only be called
+ * if there are bytes available in the read buffer. Only available if
+ * UART3_DMA_READ_STREAM is defined.
+ * @return Byte.
  */
-static inline __attribute__((always_inline)) void BlockTransferComplete(void) {
-    size_t numberOfBytes;
-    if (DCH1ECONbits.PATEN == 1) {
-        numberOfBytes = 0;
-        while (numberOfBytes < DCH1DSIZ) { // count number of bytes up to and including termination
-            if (readData[numberOfBytes++] == DCH1DAT) {
-                break;
-            }
-        }
-    } else {
-        numberOfBytes = DCH1DSIZ;
-    }
-    if (read != NULL) {
-        read(readData, numberOfBytes);
-    }
+uint8_t Uart3DmaReadByte(void) {
+    return UartDmaCoreReadByte(&uart);
 }
 
 /**
- * @brief Transfer aborted.
+ * @brief Clears the read buffer. Only available if UART3_DMA_READ_STREAM is
+ * defined.
  */
-static inline __attribute__((always_inline)) void TransferAborted(void) {
-    if (DCH1DPTR == 0) { // if no data received
-        return;
-    }
-    const size_t numberOfBytes = DCH1DPTR;
-    DCH1ECONbits.CABORT = 1; // reset DMA channel
-    if (read != NULL) {
-        read(readData, numberOfBytes);
-    }
+void Uart3DmaClearReadBuffer(void) {
+    UartDmaCoreClearReadBuffer(&uart);
 }
 
 /**
@@ -297,7 +184,7 @@ static inline __attribute__((always_inline)) void TransferAborted(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart3DmaAvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return UartDmaCoreAvailableWrite(&uart);
 }
 
 /**
@@ -307,22 +194,61 @@ size_t Uart3DmaAvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart3DmaWrite(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
-    if (Uart3DmaWriteTransferInProgress() == false) {
-        WriteTransferComplete();
-    }
-    return result;
+    return UartDmaCoreWrite(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart3DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartDmaCoreWritev(&uart, vectors, numberOfVectors);
 }
 
 /**
- * @brief Write transfer complete callback.
+ * @brief Writes a break character to the write buffer. The UART transmits the
+ * break in place of a dummy byte written by this function. The transmitter
+ * must be idle.
+ * @return Result.
  */
-static void WriteTransferComplete(void) {
-    static __attribute__((coherent)) uint8_t data[UART3_DMA_WRITE_TRANSFER_SIZE];
-    const size_t numberOfBytes = FifoRead(&writeFifo, data, sizeof (data));
-    if (numberOfBytes > 0) {
-        Uart3DmaWriteTransfer(data, numberOfBytes, WriteTransferComplete);
-    }
+FifoResult Uart3DmaWriteBreak(void) {
+    return UartDmaCoreWriteBreak(&uart);
+}
+
+/**
+ * @brief Returns the space available in the high-priority write buffer.
+ * @return Space available in the high-priority write buffer.
+ */
+size_t Uart3DmaAvailableWriteHighPriority(void) {
+    return UartDmaCoreAvailableWriteHighPriority(&uart);
+}
+
+/**
+ * @brief Writes data to the high-priority write buffer. Data in the
+ * high-priority write buffer is transferred before data in the write buffer,
+ * starting from the next transfer. Not available if
+ * UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE is 0.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult Uart3DmaWriteHighPriority(const void* const data, const size_t numberOfBytes) {
+    return UartDmaCoreWriteHighPriority(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the high-priority write buffer. Either all
+ * or none of the data will be written. Not available if
+ * UART3_DMA_HIGH_PRIORITY_BUFFER_SIZE is 0.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart3DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartDmaCoreWritevHighPriority(&uart, vectors, numberOfVectors);
 }
 
 /**
@@ -335,22 +261,7 @@ static void WriteTransferComplete(void) {
  * unused.
  */
 void Uart3DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void)) {
-    writeTransferComplete = writeTransferComplete_;
-    DCH0SSA = KVA_TO_PA(data); // source address
-    DCH0SSIZ = numberOfBytes; // source size
-    DCH0INTbits.CHBCIF = 0; // clear TX DMA channel interrupt flag
-    DCH0CONbits.CHEN = 1; // enable TX DMA channel to begin write
-}
-
-/**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
- */
-void Dma0InterruptHandler(void) {
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0); // clear interrupt flag first because callback may start new write
-    if (writeTransferComplete != NULL) {
-        writeTransferComplete();
-    }
+    UartDmaCoreWriteTransfer(&uart, data, numberOfBytes, writeTransferComplete_);
 }
 
 /**
@@ -358,14 +269,33 @@ void Dma0InterruptHandler(void) {
  * @return True while data is being transferred to the transmit buffer.
  */
 bool Uart3DmaWriteTransferInProgress(void) {
-    return DCH0CONbits.CHEN == 1;
+    return UartDmaCoreWriteTransferInProgress(&uart);
 }
 
 /**
  * @brief Clears the write buffer.
  */
 void Uart3DmaClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    UartDmaCoreClearWriteBuffer(&uart);
+}
+
+/**
+ * @brief Gets the write statistics. The maximum values are reset each time
+ * this function is called.
+ * @param statistics Write buffer statistics.
+ * @param highPriorityStatistics High-priority write buffer statistics.
+ */
+void Uart3DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics) {
+    UartDmaCoreGetWriteStatistics(&uart, statistics, highPriorityStatistics);
+}
+
+/**
+ * @brief Gets the RX DMA channel interrupt statistics since the previous call.
+ * Statistics are not available if UART3_DMA_READ_STREAM is defined.
+ * @param statistics Statistics.
+ */
+void Uart3DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics) {
+    UartDmaCoreGetReadInterruptStatistics(&uart, statistics);
 }
 
 /**
@@ -374,11 +304,7 @@ void Uart3DmaClearWriteBuffer(void) {
  * @return True if the receive buffer has overrun.
  */
 bool Uart3DmaReceiveBufferOverrun(void) {
-    if (receiveBufferOverrun) {
-        receiveBufferOverrun = false;
-        return true;
-    }
-    return false;
+    return UartDmaCoreReceiveBufferOverrun(&uart);
 }
 
 /**
@@ -386,8 +312,73 @@ bool Uart3DmaReceiveBufferOverrun(void) {
  * @return True if all data has been transmitted.
  */
 bool Uart3DmaTransmissionComplete(void) {
-    return (Uart3DmaWriteTransferInProgress() == false) && (U3STAbits.TRMT == 1);
+    return UartDmaCoreTransmissionComplete(&uart);
 }
 
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ */
+void Uart3DmaStartAutoBaud(void) {
+    UartDmaCoreStartAutoBaud(&uart);
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @return True while auto-baud is in progress.
+ */
+bool Uart3DmaAutoBaudInProgress(void) {
+    return UartDmaCoreAutoBaudInProgress(&uart);
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @return Baud rate.
+ */
+float Uart3DmaGetBaudRate(void) {
+    return UartDmaCoreGetBaudRate(&uart);
+}
+
+/**
+ * @brief RX DMA channel interrupt handler.
+ */
+static void RxDmaInterruptHandler(void) {
+    UartDmaCoreRxDmaInterruptHandler(&uart);
+}
+
+/**
+ * @brief TX DMA channel interrupt handler.
+ */
+static void TxDmaInterruptHandler(void) {
+    UartDmaCoreTxDmaInterruptHandler(&uart);
+}
+
+#ifdef _UART_3_VECTOR
+
+/**
+ * @brief UART RX and TX interrupt handler. This function should be called by
+ * the ISR implementation generated by MPLAB Harmony. Only required if the
+ * RS-485 driver enable is used.
+ */
+void Uart3InterruptHandler(void) {
+    UartDmaCoreInterruptHandler(&uart);
+}
+
+#else
+
+/**
+ * @brief UART TX interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony. Only required if the RS-485
+ * driver enable is used.
+ */
+void Uart3TxInterruptHandler(void) {
+    UartDmaCoreTxInterruptHandler(&uart);
+}
+
+#endif
+
 //------------------------------------------------------------------------------
 // End of file
@@ -1,7 +1,10 @@
 /**
  * @file Uart3Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart3TxInterruptHandler, or
+ * Uart3InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART3_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart3DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart3DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart3DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart3DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart3DmaDeinitialise(void);
 void Uart3DmaTasks(void);
+size_t Uart3DmaAvailableRead(void);
+size_t Uart3DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart3DmaReadByte(void);
+void Uart3DmaClearReadBuffer(void);
 size_t Uart3DmaAvailableWrite(void);
 FifoResult Uart3DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart3DmaWriteBreak(void);
+size_t Uart3DmaAvailableWriteHighPriority(void);
+FifoResult Uart3DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart3DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart3DmaWriteTransferInProgress(void);
 void Uart3DmaClearWriteBuffer(void);
+void Uart3DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart3DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart3DmaReceiveBufferOverrun(void);
 bool Uart3DmaTransmissionComplete(void);
+void Uart3DmaStartAutoBaud(void);
+bool Uart3DmaAutoBaudInProgress(void);
+float Uart3DmaGetBaudRate(void);
 
 #endif
 
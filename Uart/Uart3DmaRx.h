@@ -1,7 +1,10 @@
 /**
  * @file Uart3DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart3TxInterruptHandler,
+ * or Uart3InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART3_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart3DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart3DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart3DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart3DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart3DmaRxDeinitialise(void);
 void Uart3DmaRxTasks(void);
+size_t Uart3DmaRxAvailableRead(void);
+size_t Uart3DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart3DmaRxReadByte(void);
+void Uart3DmaRxClearReadBuffer(void);
 size_t Uart3DmaRxAvailableWrite(void);
 FifoResult Uart3DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart3DmaRxWriteByte(const uint8_t byte);
 void Uart3DmaRxClearWriteBuffer(void);
+void Uart3DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart3DmaRxReceiveBufferOverrun(void);
 bool Uart3DmaRxTransmissionComplete(void);
+void Uart3DmaRxStartAutoBaud(void);
+bool Uart3DmaRxAutoBaudInProgress(void);
+float Uart3DmaRxGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,11 @@
 /**
  * @file Uart3DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart3RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart3TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart3InterruptHandler instead.
  */
 
 #ifndef UART3_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart3DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart3DmaTxInitialise(const UartSettings * const settings);
 void Uart3DmaTxDeinitialise(void);
 size_t Uart3DmaTxAvailableRead(void);
 size_t Uart3DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart3DmaTxReadByte(void);
+FifoResult Uart3DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart3DmaTxAvailableWrite(void);
 FifoResult Uart3DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart3DmaTxWriteBreak(void);
+size_t Uart3DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart3DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart3DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart3DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart3DmaTxWriteTransferInProgress(void);
 void Uart3DmaTxClearReadBuffer(void);
 void Uart3DmaTxClearWriteBuffer(void);
+void Uart3DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart3DmaTxReceiveBufferOverrun(void);
 bool Uart3DmaTxTransmissionComplete(void);
+void Uart3DmaTxStartAutoBaud(void);
+bool Uart3DmaTxAutoBaudInProgress(void);
+float Uart3DmaTxGetBaudRate(void);
 
 #endif
 
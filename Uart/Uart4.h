@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart4Initialise(const UartSettings * const settings);
+UartResult Uart4Initialise(const UartSettings * const settings);
 void Uart4Deinitialise(void);
+void Uart4Tasks(void);
 size_t Uart4AvailableRead(void);
 size_t Uart4Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart4ReadByte(void);
+FifoResult Uart4Find(const uint8_t byte, size_t * const offset);
 size_t Uart4AvailableWrite(void);
 FifoResult Uart4Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart4WriteByte(const uint8_t byte);
 void Uart4ClearReadBuffer(void);
 void Uart4ClearWriteBuffer(void);
 bool Uart4ReceiveBufferOverrun(void);
 bool Uart4TransmissionComplete(void);
+void Uart4StartAutoBaud(void);
+bool Uart4AutoBaudInProgress(void);
+float Uart4GetBaudRate(void);
+void Uart4GetStatistics(UartStatistics * const statistics);
 
 #endif
 
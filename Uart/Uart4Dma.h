@@ -1,7 +1,10 @@
 /**
  * @file Uart4Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart4TxInterruptHandler, or
+ * Uart4InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART4_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart4DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart4DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart4DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart4DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart4DmaDeinitialise(void);
 void Uart4DmaTasks(void);
+size_t Uart4DmaAvailableRead(void);
+size_t Uart4DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart4DmaReadByte(void);
+void Uart4DmaClearReadBuffer(void);
 size_t Uart4DmaAvailableWrite(void);
 FifoResult Uart4DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart4DmaWriteBreak(void);
+size_t Uart4DmaAvailableWriteHighPriority(void);
+FifoResult Uart4DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart4DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart4DmaWriteTransferInProgress(void);
 void Uart4DmaClearWriteBuffer(void);
+void Uart4DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart4DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart4DmaReceiveBufferOverrun(void);
 bool Uart4DmaTransmissionComplete(void);
+void Uart4DmaStartAutoBaud(void);
+bool Uart4DmaAutoBaudInProgress(void);
+float Uart4DmaGetBaudRate(void);
 
 #endif
 
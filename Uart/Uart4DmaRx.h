@@ -1,7 +1,10 @@
 /**
  * @file Uart4DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart4TxInterruptHandler,
+ * or Uart4InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART4_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart4DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart4DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart4DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart4DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart4DmaRxDeinitialise(void);
 void Uart4DmaRxTasks(void);
+size_t Uart4DmaRxAvailableRead(void);
+size_t Uart4DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart4DmaRxReadByte(void);
+void Uart4DmaRxClearReadBuffer(void);
 size_t Uart4DmaRxAvailableWrite(void);
 FifoResult Uart4DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart4DmaRxWriteByte(const uint8_t byte);
 void Uart4DmaRxClearWriteBuffer(void);
+void Uart4DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart4DmaRxReceiveBufferOverrun(void);
 bool Uart4DmaRxTransmissionComplete(void);
+void Uart4DmaRxStartAutoBaud(void);
+bool Uart4DmaRxAutoBaudInProgress(void);
+float Uart4DmaRxGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,11 @@
 /**
  * @file Uart4DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart4RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart4TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart4InterruptHandler instead.
  */
 
 #ifndef UART4_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart4DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart4DmaTxInitialise(const UartSettings * const settings);
 void Uart4DmaTxDeinitialise(void);
 size_t Uart4DmaTxAvailableRead(void);
 size_t Uart4DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart4DmaTxReadByte(void);
+FifoResult Uart4DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart4DmaTxAvailableWrite(void);
 FifoResult Uart4DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart4DmaTxWriteBreak(void);
+size_t Uart4DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart4DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart4DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart4DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart4DmaTxWriteTransferInProgress(void);
 void Uart4DmaTxClearReadBuffer(void);
 void Uart4DmaTxClearWriteBuffer(void);
+void Uart4DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart4DmaTxReceiveBufferOverrun(void);
 bool Uart4DmaTxTransmissionComplete(void);
+void Uart4DmaTxStartAutoBaud(void);
+bool Uart4DmaTxAutoBaudInProgress(void);
+float Uart4DmaTxGetBaudRate(void);
 
 #endif
 
@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart5Initialise(const UartSettings * const settings);
+UartResult Uart5Initialise(const UartSettings * const settings);
 void Uart5Deinitialise(void);
+void Uart5Tasks(void);
 size_t Uart5AvailableRead(void);
 size_t Uart5Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart5ReadByte(void);
+FifoResult Uart5Find(const uint8_t byte, size_t * const offset);
 size_t Uart5AvailableWrite(void);
 FifoResult Uart5Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart5WriteByte(const uint8_t byte);
 void Uart5ClearReadBuffer(void);
 void Uart5ClearWriteBuffer(void);
 bool Uart5ReceiveBufferOverrun(void);
 bool Uart5TransmissionComplete(void);
+void Uart5StartAutoBaud(void);
+bool Uart5AutoBaudInProgress(void);
+float Uart5GetBaudRate(void);
+void Uart5GetStatistics(UartStatistics * const statistics);
 
 #endif
 
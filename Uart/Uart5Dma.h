@@ -1,7 +1,10 @@
 /**
  * @file Uart5Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart5TxInterruptHandler, or
+ * Uart5InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART5_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart5DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart5DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart5DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart5DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart5DmaDeinitialise(void);
 void Uart5DmaTasks(void);
+size_t Uart5DmaAvailableRead(void);
+size_t Uart5DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart5DmaReadByte(void);
+void Uart5DmaClearReadBuffer(void);
 size_t Uart5DmaAvailableWrite(void);
 FifoResult Uart5DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart5DmaWriteBreak(void);
+size_t Uart5DmaAvailableWriteHighPriority(void);
+FifoResult Uart5DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart5DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart5DmaWriteTransferInProgress(void);
 void Uart5DmaClearWriteBuffer(void);
+void Uart5DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart5DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart5DmaReceiveBufferOverrun(void);
 bool Uart5DmaTransmissionComplete(void);
+void Uart5DmaStartAutoBaud(void);
+bool Uart5DmaAutoBaudInProgress(void);
+float Uart5DmaGetBaudRate(void);
 
 #endif
 
@@ -2,6 +2,7 @@
  * @file Uart5DmaRx.c
  * @author Seb Madgwick
  * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * Wrapper of UartDmaCore.
  */
 
 //------------------------------------------------------------------------------
@@ -9,29 +10,67 @@
 
 #include "Config.h"
 #include "definitions.h"
-#include "sys/kmem.h"
-#include "Timer/Timer.h"
 #include "Uart5DmaRx.h"
+#include "UartDmaCore.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+#if defined UART5_DMA_PING_PONG && defined UART5_DMA_READ_STREAM
+#error "UART5_DMA_PING_PONG cannot be used with UART5_DMA_READ_STREAM."
+#endif
+
+#if defined UART5_DMA_READ_DEFERRED && defined UART5_DMA_READ_STREAM
+#error "UART5_DMA_READ_DEFERRED cannot be used with UART5_DMA_READ_STREAM."
+#endif
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-static inline __attribute__((always_inline)) void BlockTransferComplete(void);
-static inline __attribute__((always_inline)) void TransferAborted(void);
-static inline __attribute__((always_inline)) void TxInterruptTasks(void);
+static void RxDmaInterruptHandler(void);
 
 //------------------------------------------------------------------------------
 // Variables
 
-#ifdef UART5_DMA_TIMEOUT_POLL
-static uint64_t readTimeoutTicks;
-static uint64_t readTimeoutExpiry;
-#endif
-static bool receiveBufferOverrun;
-static void (*read)(const void* const data, const size_t numberOfBytes);
+#if defined UART5_DMA_READ_STREAM
+static uint8_t __attribute__((coherent)) readData[UART5_READ_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#elif defined UART5_DMA_PING_PONG || defined UART5_DMA_READ_DEFERRED
+static uint8_t __attribute__((coherent)) readDataPing[UART5_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+static uint8_t __attribute__((coherent)) readDataPong[UART5_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#else
 static uint8_t __attribute__((coherent)) readData[UART5_DMA_READ_TRANSFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+#endif
+static uint32_t __attribute__((coherent)) timerReset[1]; // must be declared __attribute__((coherent)) for PIC32MZ devices
 static uint8_t writeData[UART5_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+static UartDmaCore uart = {
+    .registers = (UartRegisters*) &U5MODE,
+    .rxInterruptSource = INT_SOURCE_UART5_RX,
+    .txInterruptSource = INT_SOURCE_UART5_TX,
+    .rxIrq = _UART5_RX_VECTOR,
+    .txIrq = _UART5_TX_VECTOR,
+#if defined UART5_DMA_READ_STREAM
+    .readMode = UartDmaReadModeStream,
+    .readStream = {.data = readData, .dataSize = sizeof (readData)},
+#elif defined UART5_DMA_READ_DEFERRED
+    .readMode = UartDmaReadModeDeferred,
+    .readDataPing = readDataPing,
+    .readDataPong = readDataPong,
+#elif defined UART5_DMA_PING_PONG
+    .readMode = UartDmaReadModePingPong,
+    .readDataPing = readDataPing,
+    .readDataPong = readDataPong,
+#else
+    .readMode = UartDmaReadModeBlock,
+    .readDataPing = readData,
+#endif
+#ifdef UART5_DMA_TIMEOUT_POLL
+    .readTimeoutPoll = true,
+#endif
+    .rxDmaInterruptHandler = RxDmaInterruptHandler,
+    .readTransferSize = UART5_DMA_READ_TRANSFER_SIZE,
+    .timerReset = timerReset,
+    .writeFifo = {.data = writeData, .dataSize = FIFO_POW2_DATA_SIZE(sizeof (writeData))},
+};
 
 //------------------------------------------------------------------------------
 // Functions
@@ -41,135 +80,46 @@ static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
  * @param settings Settings.
  * @param readConditions Read conditions.
  * @param read Read callback. NULL if unused.
+ * @return Result. UartResultError if the baud rate is zero or if the DMA
+ * channels or read timeout timer could not be allocated.
  */
-void Uart5DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes)) {
-
-    // Ensure default register states
-    Uart5DmaRxDeinitialise();
-
-    // Configure UART
-    if (settings->rtsCtsEnabled) {
-        U5MODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
-    }
-    if (settings->invertTxRx) {
-        U5MODEbits.RXINV = 1; // UxRX Idle state is '0'
-        U5STAbits.UTXINV = 1; // UxTX Idle state is '0'
-    }
-    U5MODEbits.PDSEL = settings->parityAndData;
-    U5MODEbits.STSEL = settings->stopBits;
-    U5MODEbits.BRGH = 1; // high-Speed mode - 4x baud clock enabled
-    U5STAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
-    U5STAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
-    U5STAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
-    U5BRG = UartCalculateUxbrg(settings->baudRate);
-    U5MODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
-
-    // Store read arguments
-#ifdef UART5_DMA_TIMEOUT_POLL
-    readTimeoutTicks = (uint64_t) readConditions->timeout * TIMER_TICKS_PER_MILLISECOND;
-#endif
-    read = read_;
-
-    // Enable DMA
-    DMACONbits.ON = 1;
+UartResult Uart5DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes)) {
+    return UartDmaCoreInitialise(&uart, settings, readConditions, read_);
+}
 
-    // Configure RX DMA channel
-#ifndef UART5_DMA_TIMEOUT_POLL
-    DCH0ECONbits.CHAIRQ = _TIMER_9_VECTOR; // channel transfer abort IRQ
-    DCH0ECONbits.AIRQEN = 1; // channel transfer is aborted if an interrupt matching CHAIRQ occurs
-#endif
-    DCH0ECONbits.CHSIRQ = _UART5_RX_VECTOR; // channel transfer start IRQ
-    DCH0ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    if (readConditions->termination != -1) {
-        DCH0ECONbits.PATEN = 1; // abort transfer and clear CHEN on pattern match
-    }
-    DCH0SSA = KVA_TO_PA(&U5RXREG); // source address
-    DCH0DSA = KVA_TO_PA(readData); // destination address
-    DCH0SSIZ = 1; // source size
-    DCH0DSIZ = readConditions->numberOfBytes > sizeof (readData) ? sizeof (readData) : readConditions->numberOfBytes; // destination size
-    DCH0CSIZ = 1; // transfers per event
-    DCH0DAT = readConditions->termination & 0xFF; // pattern data
-    DCH0INTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
-    DCH0INTbits.CHTAIE = 1; // channel transfer abort interrupt enable bit
-    DCH0CONbits.CHEN = 1; // channel is enabled
-
-    // Calculate timer reset value
-#ifndef UART5_DMA_TIMEOUT_POLL
-    static uint32_t __attribute__((coherent)) timerReset[1]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-    timerReset[0] = UartDmaCalculateTimerReset(readConditions->timeout);
-
-    // Configure timer DMA channel
-    DCH1CONbits.CHAEN = 1; // channel is continuously enabled, and not automatically disabled after a block transfer is complete
-    DCH1ECONbits.CHSIRQ = _UART5_RX_VECTOR; // channel transfer start IRQ
-    DCH1ECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
-    DCH1SSA = KVA_TO_PA(timerReset); // source address
-    DCH1DSA = KVA_TO_PA(&TMR8); // destination address
-    DCH1SSIZ = sizeof (timerReset); // source size
-    DCH1DSIZ = sizeof (timerReset); // destination size
-    DCH1CSIZ = sizeof (timerReset); // transfers per event
-    DCH1CONbits.CHEN = 1; // channel is enabled
-
-    // Configure timer
-    T8CONbits.T32 = 1;
-    T8CONbits.ON = 1;
-#endif
+/**
+ * @brief Initialises the module with a read callback that also receives the
+ * time of the first byte and the time of completion of each read. The first
+ * byte is timestamped by the RX DMA channel cell transfer complete interrupt.
+ * Timestamps are not available if UART5_DMA_READ_STREAM is defined.
+ * @param settings Settings.
+ * @param readConditions Read conditions.
+ * @param readTimestamped Read callback.
+ * @return Result.
+ */
+UartResult Uart5DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps)) {
+    return UartDmaCoreInitialiseTimestamped(&uart, settings, readConditions, readTimestamped_);
+}
 
-    // Enable interrupts
-    EVIC_SourceEnable(INT_SOURCE_DMA0);
+/**
+ * @brief Sets the bridge that each read is forwarded to from Uart5DmaRxTasks.
+ * The read callback may be used as a tap. Data is transferred directly from
+ * the read buffer if the bridge provides a write transfer function that is not
+ * in progress. Otherwise, data is written to the bridge write buffer. The read
+ * buffer is not reused until the transfer is complete. This function must be
+ * called after initialisation. The bridge is only available if
+ * UART5_DMA_READ_DEFERRED is defined.
+ * @param bridge_ Bridge. NULL to disable.
+ */
+void Uart5DmaRxSetBridge(const UartDmaBridge * const bridge_) {
+    UartDmaCoreSetBridge(&uart, bridge_);
 }
 
 /**
  * @brief Deinitialises the module.
  */
 void Uart5DmaRxDeinitialise(void) {
-
-    // Disable UART and restore default register states
-    U5MODE = 0;
-    U5STA = 0;
-
-    // Disable RX DMA channel and restore default register states
-    DCH0CON = 0;
-    DCH0ECON = 0;
-    DCH0INT = 0;
-    DCH0SSA = 0;
-    DCH0DSA = 0;
-    DCH0SSIZ = 0;
-    DCH0DSIZ = 0;
-    DCH0SPTR = 0;
-    DCH0DPTR = 0;
-    DCH0CSIZ = 0;
-    DCH0CPTR = 0;
-    DCH0DAT = 0;
-
-    // Disable timer DMA channel and restore default register states
-#ifndef UART5_DMA_TIMEOUT_POLL
-    DCH1CON = 0;
-    DCH1ECON = 0;
-    DCH1INT = 0;
-    DCH1SSA = 0;
-    DCH1DSA = 0;
-    DCH1SSIZ = 0;
-    DCH1DSIZ = 0;
-    DCH1SPTR = 0;
-    DCH1DPTR = 0;
-    DCH1CSIZ = 0;
-    DCH1CPTR = 0;
-    DCH1DAT = 0;
-
-    // Disable timer and restore default register states
-    T8CON = 0;
-    T9CON = 0;
-#endif
-
-    // Disable interrupts
-    EVIC_SourceDisable(INT_SOURCE_DMA0);
-    EVIC_SourceDisable(INT_SOURCE_UART5_TX);
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
-    EVIC_SourceStatusClear(INT_SOURCE_UART5_TX);
-
-    // Clear buffer
-    receiveBufferOverrun = false;
-    Uart5DmaRxClearWriteBuffer();
+    UartDmaCoreDeinitialise(&uart);
 }
 
 /**
@@ -177,95 +127,47 @@ void Uart5DmaRxDeinitialise(void) {
  * main program loop.
  */
 void Uart5DmaRxTasks(void) {
+    UartDmaCoreTasks(&uart);
+}
 
-    // Clear receive buffer overrun flag
-    if (U5STAbits.OERR == 1) {
-        U5STAbits.OERR = 0;
-        receiveBufferOverrun = true;
-    }
-
-    // Do nothing else if no data available
-#ifdef UART5_DMA_TIMEOUT_POLL
-    const size_t available = DCH0DPTR;
-    static size_t previous;
-    if (available == 0) {
-        previous = 0;
-        return;
-    }
-
-    // Reset timeout if new data received
-    if (available != previous) {
-        readTimeoutExpiry = TimerGetTicks64() + readTimeoutTicks;
-        previous = available;
-        return;
-    }
-
-    // Wait for timeout
-    if (TimerGetTicks64() < readTimeoutExpiry) {
-        return;
-    }
-
-    // Read
-    DCH0INTbits.CHTAIF = 1; // trigger transfer abort interrupt
-    previous = 0;
-#endif
+/**
+ * @brief Returns the number of bytes available in the read buffer. The DMA
+ * channel writes to the read buffer continuously so data will be lost if the
+ * read buffer is not read before it is full. Only available if
+ * UART5_DMA_READ_STREAM is defined.
+ * @return Number of bytes available in the read buffer.
+ */
+size_t Uart5DmaRxAvailableRead(void) {
+    return UartDmaCoreAvailableRead(&uart);
 }
 
 /**
- * @brief DMA interrupt handler. This function should be called by the ISR
- * implementation generated by MPLAB Harmony.
+ * @brief Reads data from the read buffer. Only available if
+ * UART5_DMA_READ_STREAM is defined.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
  */
-void Dma0InterruptHandler(void) {
-
-    // Block transfer complete
-    if (DCH0INTbits.CHBCIF == 1) {
-        BlockTransferComplete();
-        DCH0INTbits.CHBCIF = 0;
-    }
-
-    // Transfer aborted
-    if (DCH0INTbits.CHTAIF == 1) {
-        TransferAborted();
-        DCH0INTbits.CHTAIF = 0;
-    }
-
-    // Re-enable channel
-    EVIC_SourceStatusClear(INT_SOURCE_DMA0);
-    DCH0CONbits.CHEN = 1;
+size_t Uart5DmaRxRead(void* const destination, size_t numberOfBytes) {
+    return UartDmaCoreRead(&uart, destination, numberOfBytes);
 }
 
 /**
- * @brief Block transfer complete.
+ * @brief Reads a byte from the read buffer. This function must only be called
+ * if there are bytes available in the read buffer. Only available if
+ * UART5_DMA_READ_STREAM is defined.
+ * @return Byte.
  */
-static inline __attribute__((always_inline)) void BlockTransferComplete(void) {
-    size_t numberOfBytes;
-    if (DCH0ECONbits.PATEN == 1) {
-        numberOfBytes = 0;
-        while (numberOfBytes < DCH0DSIZ) { // count number of bytes up to and including termination
-            if (readData[numberOfBytes++] == DCH0DAT) {
-                break;
-            }
-        }
-    } else {
-        numberOfBytes = DCH0DSIZ;
-    }
-    if (read != NULL) {
-        read(readData, numberOfBytes);
-    }
+uint8_t Uart5DmaRxReadByte(void) {
+    return UartDmaCoreReadByte(&uart);
 }
 
 /**
- * @brief Transfer aborted.
+ * @brief Clears the read buffer. Only available if UART5_DMA_READ_STREAM is
+ * defined.
  */
-static inline __attribute__((always_inline)) void TransferAborted(void) {
-    if (DCH0DPTR == 0) { // if no data received
-        return;
-    }
-    const size_t numberOfBytes = DCH0DPTR;
-    DCH0ECONbits.CABORT = 1; // reset DMA channel
-    if (read != NULL) {
-        read(readData, numberOfBytes);
-    }
+void Uart5DmaRxClearReadBuffer(void) {
+    UartDmaCoreClearReadBuffer(&uart);
 }
 
 /**
@@ -273,7 +175,7 @@ static inline __attribute__((always_inline)) void TransferAborted(void) {
  * @return Space available in the write buffer.
  */
 size_t Uart5DmaRxAvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return UartDmaCoreAvailableWrite(&uart);
 }
 
 /**
@@ -283,9 +185,18 @@ size_t Uart5DmaRxAvailableWrite(void) {
  * @return Result.
  */
 FifoResult Uart5DmaRxWrite(const void* const data, const size_t numberOfBytes) {
-    const FifoResult result = FifoWrite(&writeFifo, data, numberOfBytes);
-    EVIC_SourceEnable(INT_SOURCE_UART5_TX);
-    return result;
+    return UartDmaCoreWrite(&uart, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult Uart5DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return UartDmaCoreWritev(&uart, vectors, numberOfVectors);
 }
 
 /**
@@ -294,16 +205,23 @@ FifoResult Uart5DmaRxWrite(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult Uart5DmaRxWriteByte(const uint8_t byte) {
-    const FifoResult result = FifoWriteByte(&writeFifo, byte);
-    EVIC_SourceEnable(INT_SOURCE_UART5_TX);
-    return result;
+    return UartDmaCoreWriteByte(&uart, byte);
 }
 
 /**
  * @brief Clears the write buffer.
  */
 void Uart5DmaRxClearWriteBuffer(void) {
-    FifoClear(&writeFifo);
+    UartDmaCoreClearWriteBuffer(&uart);
+}
+
+/**
+ * @brief Gets the RX DMA channel interrupt statistics since the previous call.
+ * Statistics are not available if UART5_DMA_READ_STREAM is defined.
+ * @param statistics Statistics.
+ */
+void Uart5DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics) {
+    UartDmaCoreGetReadInterruptStatistics(&uart, statistics);
 }
 
 /**
@@ -312,11 +230,7 @@ void Uart5DmaRxClearWriteBuffer(void) {
  * @return True if the receive buffer has overrun.
  */
 bool Uart5DmaRxReceiveBufferOverrun(void) {
-    if (receiveBufferOverrun) {
-        receiveBufferOverrun = false;
-        return true;
-    }
-    return false;
+    return UartDmaCoreReceiveBufferOverrun(&uart);
 }
 
 /**
@@ -324,7 +238,41 @@ bool Uart5DmaRxReceiveBufferOverrun(void) {
  * @return True if all data has been transmitted.
  */
 bool Uart5DmaRxTransmissionComplete(void) {
-    return (EVIC_SourceIsEnabled(INT_SOURCE_UART5_TX) == false) && (U5STAbits.TRMT == 1);
+    return UartDmaCoreTransmissionComplete(&uart);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ */
+void Uart5DmaRxStartAutoBaud(void) {
+    UartDmaCoreStartAutoBaud(&uart);
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @return True while auto-baud is in progress.
+ */
+bool Uart5DmaRxAutoBaudInProgress(void) {
+    return UartDmaCoreAutoBaudInProgress(&uart);
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @return Baud rate.
+ */
+float Uart5DmaRxGetBaudRate(void) {
+    return UartDmaCoreGetBaudRate(&uart);
+}
+
+/**
+ * @brief RX DMA channel interrupt handler.
+ */
+static void RxDmaInterruptHandler(void) {
+    UartDmaCoreRxDmaInterruptHandler(&uart);
 }
 
 #ifdef _UART_5_VECTOR
@@ -334,35 +282,20 @@ bool Uart5DmaRxTransmissionComplete(void) {
  * the ISR implementation generated by MPLAB Harmony.
  */
 void Uart5InterruptHandler(void) {
-    TxInterruptTasks();
+    UartDmaCoreInterruptHandler(&uart);
 }
 
 #else
 
 /**
- * @brief UART TX interrupt handler. This function should be called by the
- * ISR implementation generated by MPLAB Harmony.
+ * @brief UART TX interrupt handler. This function should be called by the ISR
+ * implementation generated by MPLAB Harmony.
  */
 void Uart5TxInterruptHandler(void) {
-    TxInterruptTasks();
+    UartDmaCoreTxInterruptHandler(&uart);
 }
 
 #endif
 
-/**
- * @brief UART TX interrupt tasks.
- */
-static inline __attribute__((always_inline)) void TxInterruptTasks(void) {
-    EVIC_SourceDisable(INT_SOURCE_UART5_TX); // disable TX interrupt to avoid nested interrupt
-    EVIC_SourceStatusClear(INT_SOURCE_UART5_TX);
-    while (U5STAbits.UTXBF == 0) { // while transmit buffer not full
-        if (FifoAvailableRead(&writeFifo) == 0) { // if write buffer empty
-            return;
-        }
-        U5TXREG = FifoReadByte(&writeFifo);
-    }
-    EVIC_SourceEnable(INT_SOURCE_UART5_TX); // re-enable TX interrupt
-}
-
 //------------------------------------------------------------------------------
 // End of file
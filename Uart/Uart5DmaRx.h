@@ -1,7 +1,10 @@
 /**
  * @file Uart5DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart5TxInterruptHandler,
+ * or Uart5InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART5_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart5DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart5DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart5DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart5DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart5DmaRxDeinitialise(void);
 void Uart5DmaRxTasks(void);
+size_t Uart5DmaRxAvailableRead(void);
+size_t Uart5DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart5DmaRxReadByte(void);
+void Uart5DmaRxClearReadBuffer(void);
 size_t Uart5DmaRxAvailableWrite(void);
 FifoResult Uart5DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart5DmaRxWriteByte(const uint8_t byte);
 void Uart5DmaRxClearWriteBuffer(void);
+void Uart5DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart5DmaRxReceiveBufferOverrun(void);
 bool Uart5DmaRxTransmissionComplete(void);
+void Uart5DmaRxStartAutoBaud(void);
+bool Uart5DmaRxAutoBaudInProgress(void);
+float Uart5DmaRxGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,11 @@
 /**
  * @file Uart5DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart5RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart5TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart5InterruptHandler instead.
  */
 
 #ifndef UART5_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart5DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart5DmaTxInitialise(const UartSettings * const settings);
 void Uart5DmaTxDeinitialise(void);
 size_t Uart5DmaTxAvailableRead(void);
 size_t Uart5DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart5DmaTxReadByte(void);
+FifoResult Uart5DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart5DmaTxAvailableWrite(void);
 FifoResult Uart5DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart5DmaTxWriteBreak(void);
+size_t Uart5DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart5DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart5DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart5DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart5DmaTxWriteTransferInProgress(void);
 void Uart5DmaTxClearReadBuffer(void);
 void Uart5DmaTxClearWriteBuffer(void);
+void Uart5DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart5DmaTxReceiveBufferOverrun(void);
 bool Uart5DmaTxTransmissionComplete(void);
+void Uart5DmaTxStartAutoBaud(void);
+bool Uart5DmaTxAutoBaudInProgress(void);
+float Uart5DmaTxGetBaudRate(void);
 
 #endif
 
@@ -19,18 +19,25 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart6Initialise(const UartSettings * const settings);
+UartResult Uart6Initialise(const UartSettings * const settings);
 void Uart6Deinitialise(void);
+void Uart6Tasks(void);
 size_t Uart6AvailableRead(void);
 size_t Uart6Read(void* const destination, size_t numberOfBytes);
 uint8_t Uart6ReadByte(void);
+FifoResult Uart6Find(const uint8_t byte, size_t * const offset);
 size_t Uart6AvailableWrite(void);
 FifoResult Uart6Write(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6Writev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart6WriteByte(const uint8_t byte);
 void Uart6ClearReadBuffer(void);
 void Uart6ClearWriteBuffer(void);
 bool Uart6ReceiveBufferOverrun(void);
 bool Uart6TransmissionComplete(void);
+void Uart6StartAutoBaud(void);
+bool Uart6AutoBaudInProgress(void);
+float Uart6GetBaudRate(void);
+void Uart6GetStatistics(UartStatistics * const statistics);
 
 #endif
 
@@ -1,7 +1,10 @@
 /**
  * @file Uart6Dma.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices.
+ * @brief UART driver using DMA for PIC32 devices. If the RS-485 driver enable
+ * is used then the UART TX interrupt must be enabled in MPLAB Harmony and its
+ * ISR implementation must call Uart6TxInterruptHandler, or
+ * Uart6InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART6_DMA_H
@@ -19,16 +22,32 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart6DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart6DmaInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart6DmaInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart6DmaSetBridge(const UartDmaBridge * const bridge_);
 void Uart6DmaDeinitialise(void);
 void Uart6DmaTasks(void);
+size_t Uart6DmaAvailableRead(void);
+size_t Uart6DmaRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart6DmaReadByte(void);
+void Uart6DmaClearReadBuffer(void);
 size_t Uart6DmaAvailableWrite(void);
 FifoResult Uart6DmaWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6DmaWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart6DmaWriteBreak(void);
+size_t Uart6DmaAvailableWriteHighPriority(void);
+FifoResult Uart6DmaWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6DmaWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart6DmaWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart6DmaWriteTransferInProgress(void);
 void Uart6DmaClearWriteBuffer(void);
+void Uart6DmaGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void Uart6DmaGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart6DmaReceiveBufferOverrun(void);
 bool Uart6DmaTransmissionComplete(void);
+void Uart6DmaStartAutoBaud(void);
+bool Uart6DmaAutoBaudInProgress(void);
+float Uart6DmaGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,10 @@
 /**
  * @file Uart6DmaRx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for RX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for RX only. If the
+ * RS-485 driver enable is used then the UART TX interrupt must be enabled in
+ * MPLAB Harmony and its ISR implementation must call Uart6TxInterruptHandler,
+ * or Uart6InterruptHandler for devices with a single UART interrupt vector.
  */
 
 #ifndef UART6_DMA_RX_H
@@ -20,15 +23,26 @@
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart6DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart6DmaRxInitialise(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read_) (const void* const data, const size_t numberOfBytes));
+UartResult Uart6DmaRxInitialiseTimestamped(const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped_) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void Uart6DmaRxSetBridge(const UartDmaBridge * const bridge_);
 void Uart6DmaRxDeinitialise(void);
 void Uart6DmaRxTasks(void);
+size_t Uart6DmaRxAvailableRead(void);
+size_t Uart6DmaRxRead(void* const destination, size_t numberOfBytes);
+uint8_t Uart6DmaRxReadByte(void);
+void Uart6DmaRxClearReadBuffer(void);
 size_t Uart6DmaRxAvailableWrite(void);
 FifoResult Uart6DmaRxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6DmaRxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult Uart6DmaRxWriteByte(const uint8_t byte);
 void Uart6DmaRxClearWriteBuffer(void);
+void Uart6DmaRxGetReadInterruptStatistics(UartDmaReadInterruptStatistics * const statistics);
 bool Uart6DmaRxReceiveBufferOverrun(void);
 bool Uart6DmaRxTransmissionComplete(void);
+void Uart6DmaRxStartAutoBaud(void);
+bool Uart6DmaRxAutoBaudInProgress(void);
+float Uart6DmaRxGetBaudRate(void);
 
 #endif
 
@@ -1,7 +1,11 @@
 /**
  * @file Uart6DmaTx.h
  * @author Seb Madgwick
- * @brief UART driver using DMA for PIC32 devices. DMA used for TX only.
+ * @brief UART driver using DMA for PIC32 devices. DMA used for TX only. The
+ * ISR implementation generated by MPLAB Harmony must call
+ * Uart6RxInterruptHandler and, if the RS-485 driver enable is used,
+ * Uart6TxInterruptHandler. Devices with a single UART interrupt vector must
+ * call Uart6InterruptHandler instead.
  */
 
 #ifndef UART6_DMA_TX_H
@@ -15,23 +19,34 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "Uart.h"
+#include "UartDma.h"
 
 //------------------------------------------------------------------------------
 // Function declarations
 
-void Uart6DmaTxInitialise(const UartSettings * const settings);
+UartResult Uart6DmaTxInitialise(const UartSettings * const settings);
 void Uart6DmaTxDeinitialise(void);
 size_t Uart6DmaTxAvailableRead(void);
 size_t Uart6DmaTxRead(void* const destination, size_t numberOfBytes);
 uint8_t Uart6DmaTxReadByte(void);
+FifoResult Uart6DmaTxFind(const uint8_t byte, size_t * const offset);
 size_t Uart6DmaTxAvailableWrite(void);
 FifoResult Uart6DmaTxWrite(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6DmaTxWritev(const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult Uart6DmaTxWriteBreak(void);
+size_t Uart6DmaTxAvailableWriteHighPriority(void);
+FifoResult Uart6DmaTxWriteHighPriority(const void* const data, const size_t numberOfBytes);
+FifoResult Uart6DmaTxWritevHighPriority(const FifoVector * const vectors, const size_t numberOfVectors);
 void Uart6DmaTxWriteTransfer(const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete_) (void));
 bool Uart6DmaTxWriteTransferInProgress(void);
 void Uart6DmaTxClearReadBuffer(void);
 void Uart6DmaTxClearWriteBuffer(void);
+void Uart6DmaTxGetWriteStatistics(UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
 bool Uart6DmaTxReceiveBufferOverrun(void);
 bool Uart6DmaTxTransmissionComplete(void);
+void Uart6DmaTxStartAutoBaud(void);
+bool Uart6DmaTxAutoBaudInProgress(void);
+float Uart6DmaTxGetBaudRate(void);
 
 #endif
 
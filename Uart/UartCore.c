@@ -0,0 +1,557 @@
+/**
+ * @file UartCore.c
+ * @author Seb Madgwick
+ * @brief UART driver for PIC32 devices. A single implementation shared by all
+ * UART instances. Each instance is described by a UartCore structure.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Timer/Timer.h"
+#include "UartCore.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief RX interrupt threshold. Values equal to URXISEL bits of UxSTA
+ * register.
+ */
+typedef enum {
+    RxInterruptThresholdOne = 0b00,
+    RxInterruptThresholdHalf = 0b01,
+    RxInterruptThresholdThreeQuarters = 0b10,
+} RxInterruptThreshold;
+
+/**
+ * @brief Period over which the receive rate is measured in adaptive mode. The
+ * threshold returns to one character if no data is received for more than two
+ * periods.
+ */
+#define ADAPTIVE_PERIOD (TIMER_TICKS_PER_MILLISECOND)
+
+/**
+ * @brief Number of character times without an RX interrupt after which the
+ * threshold returns to one character in adaptive mode. Must be greater than the
+ * number of characters received between interrupts at the highest threshold.
+ */
+#define ADAPTIVE_IDLE_CHARACTERS (8)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline __attribute__((always_inline)) void RxInterruptTasks(UartCore * const uart);
+static inline __attribute__((always_inline)) void TxInterruptTasks(UartCore * const uart);
+static inline __attribute__((always_inline)) void AdaptRxInterruptThreshold(UartCore * const uart, const size_t numberOfBytes);
+static inline __attribute__((always_inline)) void Rs485Transmit(UartCore * const uart);
+static inline __attribute__((always_inline)) void Rs485Release(UartCore * const uart);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the UART.
+ * @param uart UART instance.
+ * @param settings Settings.
+ * @return Result. UartResultError if the baud rate is zero, in which case the
+ * UART is deinitialised.
+ */
+UartResult UartCoreInitialise(UartCore * const uart, const UartSettings * const settings) {
+
+    // Ensure default register states
+    UartCoreDeinitialise(uart);
+    if (settings->baudRate == 0) {
+        return UartResultError;
+    }
+
+    // Configure UART
+    const UartBaudRatePlan plan = UartPlanBaudRate(settings->baudRate);
+    if (settings->rtsCtsEnabled) {
+        uart->registers->UxMODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
+    }
+    if (settings->invertTxRx) {
+        uart->registers->UxMODEbits.RXINV = 1; // UxRX Idle state is '0'
+        uart->registers->UxSTAbits.UTXINV = 1; // UxTX Idle state is '0'
+    }
+    uart->registers->UxMODEbits.PDSEL = settings->parityAndData;
+    uart->registers->UxMODEbits.STSEL = settings->stopBits;
+    if (settings->addressDetectEnabled) {
+        uart->registers->UxSTAbits.ADDR = settings->address; // address character used for automatic address detection
+        uart->registers->UxSTAbits.ADM_EN = 1; // automatic address detect mode is enabled
+    }
+    uart->registers->UxMODEbits.BRGH = plan.brgh ? 1 : 0; // 1 = high-speed mode - 4x baud clock enabled, 0 = standard speed mode - 16x baud clock enabled
+    if (settings->adaptiveRxInterrupt) {
+        uart->registers->UxSTAbits.URXISEL = RxInterruptThresholdOne; // interrupt flag bit is asserted while receive buffer is not empty (i.e., has at least 1 data character)
+    } else {
+        uart->registers->UxSTAbits.URXISEL = RxInterruptThresholdHalf; // interrupt flag bit is asserted while receive buffer is 1/2 or more full (i.e., has 4 or more data characters)
+    }
+    uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+    uart->registers->UxSTAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
+    uart->registers->UxSTAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
+    uart->registers->UxBRG = plan.uxbrg;
+    uart->registers->UxMODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
+
+    // Configure software RTS
+    UartRtsInitialise(&uart->rts, settings);
+
+    // Configure RS-485 driver enable
+    UartRs485Initialise(&uart->rs485, settings);
+
+    // Configure adaptive RX interrupt threshold
+    uart->adaptiveRxInterrupt = settings->adaptiveRxInterrupt;
+    uart->characterRate = settings->baudRate < 10 ? 1 : settings->baudRate / 10; // approximate characters per second
+    uart->adaptiveIdleTicks = (uint32_t) (((uint64_t) TIMER_TICKS_PER_SECOND * ADAPTIVE_IDLE_CHARACTERS) / uart->characterRate);
+    uart->adaptiveTicks = TimerGetTicks32();
+    uart->rxInterruptTicks = uart->adaptiveTicks;
+    uart->adaptiveBytes = 0;
+    uart->statisticsTicks = TimerGetTicks64();
+
+    // Enable interrupts
+    EVIC_SourceEnable(uart->rxInterruptSource);
+    return UartResultOk;
+}
+
+/**
+ * @brief Deinitialises the UART.
+ * @param uart UART instance.
+ */
+void UartCoreDeinitialise(UartCore * const uart) {
+
+    // Disable UART and restore default register states
+    uart->registers->UxMODE = 0;
+    uart->registers->UxSTA = 0;
+    UartRtsDeinitialise(&uart->rts);
+    UartRs485Deinitialise(&uart->rs485);
+
+    // Disable interrupts
+    EVIC_SourceDisable(uart->rxInterruptSource);
+    EVIC_SourceDisable(uart->txInterruptSource);
+    EVIC_SourceStatusClear(uart->rxInterruptSource);
+    EVIC_SourceStatusClear(uart->txInterruptSource);
+
+    // Clear buffers
+    uart->receiveBufferOverrun = false;
+    UartCoreClearReadBuffer(uart);
+    UartCoreClearWriteBuffer(uart);
+}
+
+/**
+ * @brief Tasks. Returns the RX interrupt threshold to one character if no RX
+ * interrupt has occurred for ADAPTIVE_IDLE_CHARACTERS character times so that
+ * characters below the threshold are not left in the receive buffer once the
+ * receive data stops. Only required if the adaptive RX interrupt threshold is
+ * enabled.
+ * @param uart UART instance.
+ */
+void UartCoreTasks(UartCore * const uart) {
+    if (uart->adaptiveRxInterrupt == false) {
+        return;
+    }
+    if (uart->registers->UxSTAbits.URXISEL == RxInterruptThresholdOne) {
+        return;
+    }
+    if ((TimerGetTicks32() - uart->rxInterruptTicks) < uart->adaptiveIdleTicks) {
+        return;
+    }
+    uart->registers->UxSTACLR = _U1STA_URXISEL_MASK; // interrupt flag bit is asserted while receive buffer is not empty (i.e., has at least 1 data character)
+}
+
+/**
+ * @brief Returns the number of bytes available in the read buffer.
+ * @param uart UART instance.
+ * @return Number of bytes available in the read buffer.
+ */
+size_t UartCoreAvailableRead(UartCore * const uart) {
+
+    // Trigger RX interrupt if receive buffer not empty
+    if (uart->registers->UxSTAbits.URXDA == 1) {
+        EVIC_SourceEnable(uart->rxInterruptSource);
+        EVIC_SourceStatusSet(uart->rxInterruptSource);
+    }
+
+    // Clear receive buffer overrun flag
+    if (uart->registers->UxSTAbits.OERR == 1) {
+        uart->registers->UxSTACLR = _U1STA_OERR_MASK; // atomic clear so that URXISEL writes by the RX interrupt are not lost
+        uart->receiveBufferOverrun = true;
+    }
+
+    // Assert software RTS if space available
+    UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+
+    // Return number of bytes
+    return FifoPow2AvailableRead(&uart->readFifo);
+}
+
+/**
+ * @brief Reads data from the read buffer.
+ * @param uart UART instance.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+size_t UartCoreRead(UartCore * const uart, void* const destination, size_t numberOfBytes) {
+    UartCoreAvailableRead(uart); // process receive buffer
+    numberOfBytes = FifoPow2Read(&uart->readFifo, destination, numberOfBytes);
+    UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+    return numberOfBytes;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer.
+ * @param uart UART instance.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult UartCoreFind(UartCore * const uart, const uint8_t byte, size_t * const offset) {
+    UartCoreAvailableRead(uart); // process receive buffer
+    return FifoPow2Find(&uart->readFifo, byte, offset);
+}
+
+/**
+ * @brief Reads a byte from the read buffer. This function must only be called
+ * if there are bytes available in the read buffer.
+ * @param uart UART instance.
+ * @return Byte.
+ */
+uint8_t UartCoreReadByte(UartCore * const uart) {
+    const uint8_t byte = FifoPow2ReadByte(&uart->readFifo);
+    UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+    return byte;
+}
+
+/**
+ * @brief Returns the space available in the write buffer.
+ * @param uart UART instance.
+ * @return Space available in the write buffer.
+ */
+size_t UartCoreAvailableWrite(UartCore * const uart) {
+    return FifoPow2AvailableWrite(&uart->writeFifo);
+}
+
+/**
+ * @brief Writes data to the write buffer.
+ * @param uart UART instance.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult UartCoreWrite(UartCore * const uart, const void* const data, const size_t numberOfBytes) {
+    const FifoResult result = FifoPow2Write(&uart->writeFifo, data, numberOfBytes);
+    EVIC_SourceEnable(uart->txInterruptSource);
+    return result;
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param uart UART instance.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult UartCoreWritev(UartCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors) {
+    const FifoResult result = FifoPow2Writev(&uart->writeFifo, vectors, numberOfVectors);
+    EVIC_SourceEnable(uart->txInterruptSource);
+    return result;
+}
+
+/**
+ * @brief Writes a byte to the write buffer.
+ * @param uart UART instance.
+ * @param byte Byte.
+ * @return Result.
+ */
+FifoResult UartCoreWriteByte(UartCore * const uart, const uint8_t byte) {
+    const FifoResult result = FifoPow2WriteByte(&uart->writeFifo, byte);
+    EVIC_SourceEnable(uart->txInterruptSource);
+    return result;
+}
+
+/**
+ * @brief Clears the read buffer and resets the read buffer overrun flag.
+ * @param uart UART instance.
+ */
+void UartCoreClearReadBuffer(UartCore * const uart) {
+    FifoPow2Clear(&uart->readFifo);
+    UartCoreReceiveBufferOverrun(uart); // clear flag
+}
+
+/**
+ * @brief Clears the write buffer.
+ * @param uart UART instance.
+ */
+void UartCoreClearWriteBuffer(UartCore * const uart) {
+    FifoPow2Clear(&uart->writeFifo);
+}
+
+/**
+ * @brief Returns true if the receive buffer has overrun. Calling this function
+ * will reset the flag.
+ * @param uart UART instance.
+ * @return True if the receive buffer has overrun.
+ */
+bool UartCoreReceiveBufferOverrun(UartCore * const uart) {
+    if (uart->receiveBufferOverrun) {
+        uart->receiveBufferOverrun = false;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns true if all data has been transmitted.
+ * @param uart UART instance.
+ * @return True if all data has been transmitted.
+ */
+bool UartCoreTransmissionComplete(UartCore * const uart) {
+    return (EVIC_SourceIsEnabled(uart->txInterruptSource) == false) && (uart->registers->UxSTAbits.TRMT == 1);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ * @param uart UART instance.
+ */
+void UartCoreStartAutoBaud(UartCore * const uart) {
+    uart->registers->UxMODEbits.ABAUD = 1; // enable baud rate measurement on the next character (requires reception of a Sync field (55h))
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @param uart UART instance.
+ * @return True while auto-baud is in progress.
+ */
+bool UartCoreAutoBaudInProgress(UartCore * const uart) {
+    return uart->registers->UxMODEbits.ABAUD == 1;
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @param uart UART instance.
+ * @return Baud rate.
+ */
+float UartCoreGetBaudRate(UartCore * const uart) {
+    return UartCalculateActualBaudRate(uart->registers->UxMODEbits.BRGH == 1, uart->registers->UxBRG);
+}
+
+/**
+ * @brief Gets the statistics. Rates are calculated from the counts since the
+ * previous call. Rates are zero if no time has elapsed since the previous call.
+ * @param uart UART instance.
+ * @param statistics Statistics.
+ */
+void UartCoreGetStatistics(UartCore * const uart, UartStatistics * const statistics) {
+
+    // Calculate elapsed time
+    const uint64_t ticks = TimerGetTicks64();
+    if (ticks == uart->statisticsTicks) {
+        statistics->rxInterruptsPerSecond = 0.0f;
+        statistics->txInterruptsPerSecond = 0.0f;
+        statistics->rxBytesPerSecond = 0.0f;
+        statistics->urxisel = uart->registers->UxSTAbits.URXISEL;
+        return;
+    }
+    const float seconds = (float) (ticks - uart->statisticsTicks) / (float) TIMER_TICKS_PER_SECOND;
+    uart->statisticsTicks = ticks;
+
+    // Calculate rates
+    const uint32_t rxInterrupts = uart->rxInterrupts;
+    const uint32_t txInterrupts = uart->txInterrupts;
+    const uint32_t rxBytes = uart->rxBytes;
+    statistics->rxInterruptsPerSecond = (float) (rxInterrupts - uart->rxInterruptsPrevious) / seconds;
+    statistics->txInterruptsPerSecond = (float) (txInterrupts - uart->txInterruptsPrevious) / seconds;
+    statistics->rxBytesPerSecond = (float) (rxBytes - uart->rxBytesPrevious) / seconds;
+    statistics->urxisel = uart->registers->UxSTAbits.URXISEL;
+    uart->rxInterruptsPrevious = rxInterrupts;
+    uart->txInterruptsPrevious = txInterrupts;
+    uart->rxBytesPrevious = rxBytes;
+}
+
+/**
+ * @brief UART RX and TX interrupt handler for devices with a single UART
+ * interrupt vector.
+ * @param uart UART instance.
+ */
+void UartCoreInterruptHandler(UartCore * const uart) {
+
+    // RX interrupt
+    if (EVIC_SourceStatusGet(uart->rxInterruptSource)) {
+        RxInterruptTasks(uart);
+    }
+
+    // TX interrupt
+    if (EVIC_SourceIsEnabled(uart->txInterruptSource) == false) {
+        return; // return if TX interrupt disabled because TX interrupt flag will remain set while the transmit buffer is empty
+    }
+    if (EVIC_SourceStatusGet(uart->txInterruptSource)) {
+        TxInterruptTasks(uart);
+    }
+}
+
+/**
+ * @brief UART RX interrupt handler for devices with separate UART RX and TX
+ * interrupt vectors.
+ * @param uart UART instance.
+ */
+void UartCoreRxInterruptHandler(UartCore * const uart) {
+    RxInterruptTasks(uart);
+}
+
+/**
+ * @brief UART TX interrupt handler for devices with separate UART RX and TX
+ * interrupt vectors.
+ * @param uart UART instance.
+ */
+void UartCoreTxInterruptHandler(UartCore * const uart) {
+    TxInterruptTasks(uart);
+}
+
+/**
+ * @brief UART RX interrupt tasks.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void RxInterruptTasks(UartCore * const uart) {
+    uart->rxInterrupts++;
+    size_t totalNumberOfBytes = 0;
+    while (uart->registers->UxSTAbits.URXDA == 1) { // while data available in receive buffer
+        volatile void* pointer;
+        size_t numberOfBytes;
+        FifoPow2WritePointer(&uart->readFifo, &pointer, &numberOfBytes);
+        if (numberOfBytes == 0) { // if read buffer full
+            EVIC_SourceDisable(uart->rxInterruptSource);
+            break;
+        }
+        volatile uint8_t * const destination = pointer;
+        size_t index = 0;
+        while ((uart->registers->UxSTAbits.URXDA == 1) && (index < numberOfBytes)) { // write directly to read buffer
+            destination[index++] = uart->registers->UxRXREG;
+        }
+        FifoPow2WritePointerComplete(&uart->readFifo, index);
+        totalNumberOfBytes += index;
+    }
+    uart->rxBytes += totalNumberOfBytes;
+    if (uart->adaptiveRxInterrupt) {
+        AdaptRxInterruptThreshold(uart, totalNumberOfBytes);
+    }
+    UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo)); // deassert software RTS if space below watermark
+    EVIC_SourceStatusClear(uart->rxInterruptSource);
+}
+
+/**
+ * @brief UART TX interrupt tasks.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void TxInterruptTasks(UartCore * const uart) {
+    uart->txInterrupts++;
+    EVIC_SourceDisable(uart->txInterruptSource); // disable TX interrupt to avoid nested interrupt
+    EVIC_SourceStatusClear(uart->txInterruptSource);
+    if (FifoPow2AvailableRead(&uart->writeFifo) > 0) {
+        Rs485Transmit(uart);
+    }
+    while (uart->registers->UxSTAbits.UTXBF == 0) { // while transmit buffer not full
+        if (FifoPow2AvailableRead(&uart->writeFifo) == 0) { // if write buffer empty
+            Rs485Release(uart);
+            return;
+        }
+        uart->registers->UxTXREG = FifoPow2ReadByte(&uart->writeFifo);
+    }
+    EVIC_SourceEnable(uart->txInterruptSource); // re-enable TX interrupt
+}
+
+/**
+ * @brief Adapts the RX interrupt threshold to the receive rate measured over
+ * each adaptive period. A low threshold minimises latency at low receive
+ * rates. A high threshold minimises the number of interrupts at high receive
+ * rates. Each threshold has hysteresis to avoid switching back and forth.
+ * @param uart UART instance.
+ * @param numberOfBytes Number of bytes received by the interrupt.
+ */
+static inline __attribute__((always_inline)) void AdaptRxInterruptThreshold(UartCore * const uart, const size_t numberOfBytes) {
+
+    // Wait for end of period
+    uart->adaptiveBytes += numberOfBytes;
+    const uint32_t ticks = TimerGetTicks32();
+    uart->rxInterruptTicks = ticks;
+    const uint32_t elapsedTicks = ticks - uart->adaptiveTicks;
+    if (elapsedTicks < ADAPTIVE_PERIOD) {
+        return;
+    }
+
+    // Calculate receive rate as a percentage of the maximum character rate
+    const uint32_t utilisation = (uint32_t) (((uint64_t) uart->adaptiveBytes * TIMER_TICKS_PER_SECOND * 100) / ((uint64_t) elapsedTicks * uart->characterRate));
+    uart->adaptiveTicks = ticks;
+    uart->adaptiveBytes = 0;
+
+    // Return to one character threshold if idle
+    if (elapsedTicks > (2 * ADAPTIVE_PERIOD)) {
+        uart->registers->UxSTAbits.URXISEL = RxInterruptThresholdOne;
+        return;
+    }
+
+    // Select threshold
+    RxInterruptThreshold threshold = uart->registers->UxSTAbits.URXISEL;
+    switch (threshold) {
+        case RxInterruptThresholdOne:
+            if (utilisation > 10) {
+                threshold = RxInterruptThresholdHalf;
+            }
+            break;
+        case RxInterruptThresholdHalf:
+            if (utilisation > 50) {
+                threshold = RxInterruptThresholdThreeQuarters;
+            } else if (utilisation < 5) {
+                threshold = RxInterruptThresholdOne;
+            }
+            break;
+        default:
+            if (utilisation < 25) {
+                threshold = RxInterruptThresholdHalf;
+            }
+            break;
+    }
+    uart->registers->UxSTAbits.URXISEL = threshold;
+}
+
+/**
+ * @brief Asserts the RS-485 driver enable before data is written to the
+ * transmit buffer.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void Rs485Transmit(UartCore * const uart) {
+    if (uart->rs485.enabled == false) {
+        return;
+    }
+    uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+    UartRs485Transmit(&uart->rs485);
+}
+
+/**
+ * @brief Releases the RS-485 driver enable if all characters have been
+ * transmitted. Otherwise, the TX interrupt is re-enabled to be generated when
+ * all characters have been transmitted.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void Rs485Release(UartCore * const uart) {
+    if (uart->rs485.enabled == false) {
+        return;
+    }
+    if (uart->registers->UxSTAbits.TRMT == 1) {
+        uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+        UartRs485Receive(&uart->rs485);
+        return;
+    }
+    uart->registers->UxSTAbits.UTXISEL = 0b01; // interrupt is generated and asserted when all characters have been transmitted
+    EVIC_SourceEnable(uart->txInterruptSource);
+    if (uart->registers->UxSTAbits.TRMT == 1) {
+        EVIC_SourceStatusSet(uart->txInterruptSource); // in case all characters were transmitted before UTXISEL was set
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
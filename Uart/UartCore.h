@@ -0,0 +1,82 @@
+/**
+ * @file UartCore.h
+ * @author Seb Madgwick
+ * @brief UART driver for PIC32 devices. A single implementation shared by all
+ * UART instances. Each instance is described by a UartCore structure.
+ */
+
+#ifndef UART_CORE_H
+#define UART_CORE_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Uart.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief UART instance. The registers, interrupt sources and FIFOs must be
+ * initialised by the owner of the instance. All other structure members are
+ * private.
+ */
+typedef struct {
+    UartRegisters * const registers;
+    const INT_SOURCE rxInterruptSource;
+    const INT_SOURCE txInterruptSource;
+    FifoPow2 readFifo;
+    FifoPow2 writeFifo;
+    bool receiveBufferOverrun;
+    UartRts rts;
+    UartRs485 rs485;
+    bool adaptiveRxInterrupt;
+    uint32_t characterRate;
+    uint32_t adaptiveIdleTicks;
+    uint32_t adaptiveTicks;
+    uint32_t adaptiveBytes;
+    volatile uint32_t rxInterruptTicks;
+    volatile uint32_t rxInterrupts;
+    volatile uint32_t txInterrupts;
+    volatile uint32_t rxBytes;
+    uint32_t rxInterruptsPrevious;
+    uint32_t txInterruptsPrevious;
+    uint32_t rxBytesPrevious;
+    uint64_t statisticsTicks;
+} UartCore;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+UartResult UartCoreInitialise(UartCore * const uart, const UartSettings * const settings);
+void UartCoreDeinitialise(UartCore * const uart);
+void UartCoreTasks(UartCore * const uart);
+size_t UartCoreAvailableRead(UartCore * const uart);
+size_t UartCoreRead(UartCore * const uart, void* const destination, size_t numberOfBytes);
+uint8_t UartCoreReadByte(UartCore * const uart);
+FifoResult UartCoreFind(UartCore * const uart, const uint8_t byte, size_t * const offset);
+size_t UartCoreAvailableWrite(UartCore * const uart);
+FifoResult UartCoreWrite(UartCore * const uart, const void* const data, const size_t numberOfBytes);
+FifoResult UartCoreWritev(UartCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult UartCoreWriteByte(UartCore * const uart, const uint8_t byte);
+void UartCoreClearReadBuffer(UartCore * const uart);
+void UartCoreClearWriteBuffer(UartCore * const uart);
+bool UartCoreReceiveBufferOverrun(UartCore * const uart);
+bool UartCoreTransmissionComplete(UartCore * const uart);
+void UartCoreStartAutoBaud(UartCore * const uart);
+bool UartCoreAutoBaudInProgress(UartCore * const uart);
+float UartCoreGetBaudRate(UartCore * const uart);
+void UartCoreGetStatistics(UartCore * const uart, UartStatistics * const statistics);
+void UartCoreInterruptHandler(UartCore * const uart);
+void UartCoreRxInterruptHandler(UartCore * const uart);
+void UartCoreTxInterruptHandler(UartCore * const uart);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
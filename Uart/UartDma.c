@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "definitions.h"
 #include "PeripheralBusClockFrequency.h"
 #include "UartDma.h"
 
@@ -24,6 +25,21 @@
 #error "Unsupported device."
 #endif
 
+/**
+ * @brief Timer IRQ. PIC32MX devices use IRQ numbers that differ from the
+ * vector numbers.
+ */
+#ifdef _TIMER_5_IRQ
+#define TIMER_IRQ(timer) (_TIMER_##timer##_IRQ)
+#else
+#define TIMER_IRQ(timer) (_TIMER_##timer##_VECTOR)
+#endif
+
+/**
+ * @brief Number of read timeout timers.
+ */
+#define NUMBER_OF_TIMERS (sizeof (timers) / sizeof (timers[0]))
+
 //------------------------------------------------------------------------------
 // Variables
 
@@ -33,20 +49,93 @@ const UartDmaReadConditions uartDmaReadConditionsDefault = {
     .timeout = 10,
 };
 
+static UartDmaTimer timers[] = {
+#ifdef _T8CON_T32_MASK
+    {.txcon = &T8CON, .tmrx = &TMR8, .prx = &PR8, .irq = TIMER_IRQ(9), .timers = (1 << 8) | (1 << 9), .pair = true},
+    {.txcon = &T6CON, .tmrx = &TMR6, .prx = &PR6, .irq = TIMER_IRQ(7), .timers = (1 << 6) | (1 << 7), .pair = true},
+#endif
+    {.txcon = &T4CON, .tmrx = &TMR4, .prx = &PR4, .irq = TIMER_IRQ(5), .timers = (1 << 4) | (1 << 5), .pair = true},
+#ifdef _T8CON_T32_MASK
+    {.txcon = &T9CON, .tmrx = &TMR9, .prx = &PR9, .irq = TIMER_IRQ(9), .timers = 1 << 9},
+    {.txcon = &T8CON, .tmrx = &TMR8, .prx = &PR8, .irq = TIMER_IRQ(8), .timers = 1 << 8},
+    {.txcon = &T7CON, .tmrx = &TMR7, .prx = &PR7, .irq = TIMER_IRQ(7), .timers = 1 << 7},
+    {.txcon = &T6CON, .tmrx = &TMR6, .prx = &PR6, .irq = TIMER_IRQ(6), .timers = 1 << 6},
+#endif
+    {.txcon = &T5CON, .tmrx = &TMR5, .prx = &PR5, .irq = TIMER_IRQ(5), .timers = 1 << 5},
+    {.txcon = &T4CON, .tmrx = &TMR4, .prx = &PR4, .irq = TIMER_IRQ(4), .timers = 1 << 4},
+};
+
+static uint32_t allocatedTimers;
+
 //------------------------------------------------------------------------------
 // Functions
 
 /**
- * @brief Calculates the timer reset value for a timeout.
+ * @brief Allocates a read timeout timer. Timers 2 and 3 are reserved for the
+ * Timer module. A 16-bit timer is used if the timeout is less than 65535
+ * periods of the timer peripheral clock with a 1:256 prescaler, for example,
+ * 167 ms for a 100 MHz clock. Otherwise, a 32-bit timer pair is used, for
+ * example, up to 3 hours for a 100 MHz clock. Timers are allocated from timer 9
+ * down to timer 4 so that the timers 8 and 9 used by previous versions are
+ * used first. PIC32MX devices only have timers 4 and 5 available. The timer
+ * will overflow and set its interrupt flag once the timeout has elapsed after
+ * the timer register was last written with the reset value. The timer runs
+ * continuously so an idle UART will take one RX DMA channel transfer abort
+ * interrupt per timeout period.
  * @param timeout Timeout in milliseconds.
- * @return Timer reset value.
+ * @return Timer. NULL if the timeout is greater than the maximum or if no
+ * suitable timers are available.
+ */
+UartDmaTimer* UartDmaTimerAllocate(const uint32_t timeout) {
+
+    // Select smallest prescaler for timeout
+    static const uint32_t prescalers[] = {1, 2, 4, 8, 16, 32, 64, 256};
+    const uint64_t ticks = (uint64_t) timeout * (TIMER_PERIPHERAL_CLOCK / 1000U);
+    const bool pair = (ticks / prescalers[7]) > UINT16_MAX;
+    const uint32_t maximum = pair ? UINT32_MAX : UINT16_MAX;
+    uint32_t tckps = 0;
+    while ((tckps < 7) && ((ticks / prescalers[tckps]) > maximum)) {
+        tckps++;
+    }
+    const uint64_t periods = ticks / prescalers[tckps];
+    if (periods > maximum) {
+        return NULL;
+    }
+
+    // Allocate timer
+    for (size_t index = 0; index < NUMBER_OF_TIMERS; index++) {
+        UartDmaTimer * const timer = &timers[index];
+        if ((timer->pair != pair) || ((allocatedTimers & timer->timers) != 0)) {
+            continue;
+        }
+        allocatedTimers |= timer->timers;
+        timer->reset = maximum - (uint32_t) periods;
+
+        // Configure timer
+        const uint32_t t32 = pair ? _T4CON_T32_MASK : 0;
+        *timer->txcon = t32;
+        *timer->tmrx = 0;
+        *timer->prx = maximum;
+        *timer->txcon = (tckps << _T4CON_TCKPS_POSITION) | t32 | _T4CON_ON_MASK;
+        return timer;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Disables a read timeout timer, restores the default register states
+ * and frees the timer.
+ * @param timer Timer. May be NULL.
  */
-uint32_t UartDmaCalculateTimerReset(const uint32_t timeout) {
-    const uint64_t offset = (uint64_t) timeout * (TIMER_PERIPHERAL_CLOCK / 1000U);
-    if (offset > (uint64_t) UINT32_MAX) {
-        return 0;
+void UartDmaTimerFree(UartDmaTimer * const timer) {
+    if (timer == NULL) {
+        return;
     }
-    return UINT32_MAX - offset;
+    *timer->txcon = timer->pair ? _T4CON_T32_MASK : 0;
+    *timer->tmrx = 0;
+    *timer->prx = timer->pair ? UINT32_MAX : UINT16_MAX;
+    *timer->txcon = 0;
+    allocatedTimers &= ~timer->timers;
 }
 
 //------------------------------------------------------------------------------
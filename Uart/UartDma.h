@@ -10,6 +10,8 @@
 //------------------------------------------------------------------------------
 // Includes
 
+#include "Fifo.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -17,7 +19,10 @@
 // Definitions
 
 /**
- * @brief Read conditions.
+ * @brief Read conditions. Initialisation will fail if the timeout is greater
+ * than the maximum supported by the read timeout timer, see
+ * UartDmaTimerAllocate. Unless UARTn_DMA_TIMEOUT_POLL is defined, an idle UART
+ * takes one RX DMA channel interrupt per timeout period.
  */
 typedef struct {
     size_t numberOfBytes;
@@ -25,6 +30,62 @@ typedef struct {
     uint32_t timeout; // milliseconds
 } UartDmaReadConditions;
 
+/**
+ * @brief Read timestamps. Values are TimerGetTicks64 ticks. The completion
+ * timestamp of a read ended by a timeout is the time of the timeout.
+ */
+typedef struct {
+    uint64_t firstByte;
+    uint64_t complete;
+} UartDmaReadTimestamps;
+
+/**
+ * @brief Write statistics. The latency is the time that the oldest data in the
+ * write buffer waited for its transfer to start.
+ */
+typedef struct {
+    size_t depth; // number of bytes in write buffer
+    size_t maxDepth; // number of bytes
+    uint32_t maxLatency; // microseconds
+} UartDmaWriteStatistics;
+
+/**
+ * @brief Read interrupt statistics.
+ */
+typedef struct {
+    float interruptsPerSecond;
+    float averageDuration; // microseconds
+    float maxDuration; // microseconds
+} UartDmaReadInterruptStatistics;
+
+/**
+ * @brief Bridge that reads are forwarded to. writeTransfer and
+ * writeTransferInProgress may be NULL if the destination does not support
+ * write transfers, for example: {.write = UsbCdcWrite}. The bridge writes to
+ * the destination from the tasks of the source. The destination must not be
+ * written to by anything else while bridged.
+ */
+typedef struct {
+    void (*const writeTransfer) (const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete) (void));
+    bool (*const writeTransferInProgress) (void);
+    FifoResult (*const write) (const void* const data, const size_t numberOfBytes);
+} UartDmaBridge;
+
+/**
+ * @brief Read timeout timer. Either a 16-bit timer or a 32-bit timer pair. The
+ * reset value, timer register address and IRQ may be used by the owner of the
+ * timer. All other structure members are private.
+ */
+typedef struct {
+    volatile uint32_t * const txcon;
+    volatile uint32_t * const tmrx;
+    volatile uint32_t * const prx;
+    const int irq;
+    const uint32_t timers; // bit n set if timer n is used
+    const bool pair;
+    uint32_t reset;
+} UartDmaTimer;
+
 //------------------------------------------------------------------------------
 // Variable declarations
 
@@ -33,7 +94,8 @@ extern const UartDmaReadConditions uartDmaReadConditionsDefault;
 //------------------------------------------------------------------------------
 // Function declarations
 
-uint32_t UartDmaCalculateTimerReset(const uint32_t timeout);
+UartDmaTimer* UartDmaTimerAllocate(const uint32_t timeout);
+void UartDmaTimerFree(UartDmaTimer * const timer);
 
 #endif
 
@@ -0,0 +1,1180 @@
+/**
+ * @file UartDmaCore.c
+ * @author Seb Madgwick
+ * @brief UART driver using DMA for PIC32 devices. A single implementation
+ * shared by all UART instances and DMA variants. Each instance is described by
+ * a UartDmaCore structure.
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "sys/kmem.h"
+#include "Timer/Timer.h"
+#include "UartDmaCore.h"
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static inline __attribute__((always_inline)) void RxDmaInterruptTasks(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) size_t BlockTransferComplete(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) size_t TransferAborted(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) uint8_t * Alternate(UartDmaCore * const uart, const uint8_t * const data);
+static inline __attribute__((always_inline)) void CaptureFirstByte(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) void BridgeForward(UartDmaCore * const uart, const uint8_t* const data, const size_t numberOfBytes);
+static inline __attribute__((always_inline)) bool BridgeTransferInProgress(UartDmaCore * const uart, const uint8_t* const data);
+static void ReadEnable(UartDmaCore * const uart);
+static void WriteComplete(UartDmaCore * const uart, UartDmaWriteQueue * const queue);
+static void WriteTransferComplete(UartDmaCore * const uart);
+static void GetWriteStatistics(UartDmaWriteQueue * const queue, UartDmaWriteStatistics * const statistics);
+static inline __attribute__((always_inline)) void RxInterruptTasks(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) void TxInterruptTasks(UartDmaCore * const uart);
+static inline __attribute__((always_inline)) void Rs485Transmit(UartDmaCore * const uart);
+static void Rs485Release(UartDmaCore * const uart);
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Initialises the UART.
+ * @param uart UART instance.
+ * @param settings Settings.
+ * @param readConditions Read conditions. NULL if the read mode is interrupt.
+ * @param read Read callback. NULL if unused.
+ * @return Result. UartResultError if the baud rate is zero or if the DMA
+ * channels or read timeout timer could not be allocated, in which case the UART
+ * is deinitialised.
+ */
+UartResult UartDmaCoreInitialise(UartDmaCore * const uart, const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read) (const void* const data, const size_t numberOfBytes)) {
+
+    // Ensure default register states
+    UartDmaCoreDeinitialise(uart);
+    if (settings->baudRate == 0) {
+        return UartResultError;
+    }
+
+    // Configure UART
+    const UartBaudRatePlan plan = UartPlanBaudRate(settings->baudRate);
+    if (settings->rtsCtsEnabled) {
+        uart->registers->UxMODEbits.UEN = 0b10; // UxTX, UxRX, UxCTS and UxRTS pins are enabled and used
+    }
+    if (settings->invertTxRx) {
+        uart->registers->UxMODEbits.RXINV = 1; // UxRX Idle state is '0'
+        uart->registers->UxSTAbits.UTXINV = 1; // UxTX Idle state is '0'
+    }
+    uart->registers->UxMODEbits.PDSEL = settings->parityAndData;
+    uart->registers->UxMODEbits.STSEL = settings->stopBits;
+    if (settings->addressDetectEnabled) {
+        uart->registers->UxSTAbits.ADDR = settings->address; // address character used for automatic address detection
+        uart->registers->UxSTAbits.ADM_EN = 1; // automatic address detect mode is enabled
+    }
+    uart->registers->UxMODEbits.BRGH = plan.brgh ? 1 : 0; // 1 = high-speed mode - 4x baud clock enabled, 0 = standard speed mode - 16x baud clock enabled
+    if (uart->readMode == UartDmaReadModeInterrupt) {
+        uart->registers->UxSTAbits.URXISEL = 0b01; // interrupt flag bit is asserted while receive buffer is 1/2 or more full (i.e., has 4 or more data characters)
+    }
+    if (uart->writeDma == false) {
+        uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+    }
+    uart->registers->UxSTAbits.URXEN = 1; // UARTx receiver is enabled. UxRX pin is controlled by UARTx (if ON = 1)
+    uart->registers->UxSTAbits.UTXEN = 1; // UARTx transmitter is enabled. UxTX pin is controlled by UARTx (if ON = 1)
+    uart->registers->UxBRG = plan.uxbrg;
+    uart->registers->UxMODEbits.ON = 1; // UARTx is enabled. UARTx pins are controlled by UARTx as defined by UEN<1:0> and UTXEN control bits
+
+    // Configure software RTS
+    UartRtsInitialise(&uart->rts, settings);
+
+    // Configure RS-485 driver enable
+    UartRs485Initialise(&uart->rs485, settings);
+
+    // Store read arguments
+    if ((uart->readMode != UartDmaReadModeInterrupt) && uart->readTimeoutPoll) {
+        uart->readTimeoutTicks = (uint64_t) readConditions->timeout * TIMER_TICKS_PER_MILLISECOND;
+    }
+    uart->read = read;
+    uart->readTimestamped = NULL;
+    uart->bridge = NULL;
+
+    // Allocate DMA channels
+    if (uart->writeDma) {
+        uart->txDma = DmaAllocate(uart->txDmaInterruptHandler);
+        if (uart->txDma == NULL) {
+            UartDmaCoreDeinitialise(uart);
+            return UartResultError;
+        }
+    }
+    if (uart->readMode == UartDmaReadModeStream) {
+        uart->rxDma = DmaAllocate(NULL);
+    } else if (uart->readMode != UartDmaReadModeInterrupt) {
+        uart->rxDma = DmaAllocate(uart->rxDmaInterruptHandler);
+        if (uart->readTimeoutPoll == false) {
+            uart->timerDma = DmaAllocate(NULL);
+            uart->timer = UartDmaTimerAllocate(readConditions->timeout);
+            if ((uart->timerDma == NULL) || (uart->timer == NULL)) {
+                UartDmaCoreDeinitialise(uart);
+                return UartResultError;
+            }
+        }
+    }
+    if ((uart->readMode != UartDmaReadModeInterrupt) && (uart->rxDma == NULL)) {
+        UartDmaCoreDeinitialise(uart);
+        return UartResultError;
+    }
+
+    // Configure TX DMA channel
+    if (uart->writeDma) {
+        uart->txDma->registers->DCHxECONbits.CHSIRQ = uart->txIrq; // channel transfer start IRQ
+        uart->txDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+        uart->txDma->registers->DCHxDSA = KVA_TO_PA(&uart->registers->UxTXREG); // destination address
+        uart->txDma->registers->DCHxDSIZ = 1; // destination size
+        uart->txDma->registers->DCHxCSIZ = 1; // transfers per event
+        uart->txDma->registers->DCHxINTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
+    }
+
+    // Configure RX DMA channel
+    if (uart->readMode == UartDmaReadModeStream) {
+        uart->rxDma->registers->DCHxCONbits.CHAEN = 1; // channel is continuously enabled, and not automatically disabled after a block transfer is complete
+        uart->rxDma->registers->DCHxECONbits.CHSIRQ = uart->rxIrq; // channel transfer start IRQ
+        uart->rxDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+        uart->rxDma->registers->DCHxSSA = KVA_TO_PA(&uart->registers->UxRXREG); // source address
+        uart->rxDma->registers->DCHxDSA = KVA_TO_PA(uart->readStream.data); // destination address
+        uart->rxDma->registers->DCHxSSIZ = 1; // source size
+        uart->rxDma->registers->DCHxDSIZ = uart->readStream.dataSize; // destination size
+        uart->rxDma->registers->DCHxCSIZ = 1; // transfers per event
+        uart->rxDma->registers->DCHxCONbits.CHEN = 1; // channel is enabled
+    } else if (uart->readMode != UartDmaReadModeInterrupt) {
+        if (uart->readTimeoutPoll == false) {
+            uart->rxDma->registers->DCHxECONbits.CHAIRQ = uart->timer->irq; // channel transfer abort IRQ
+            uart->rxDma->registers->DCHxECONbits.AIRQEN = 1; // channel transfer is aborted if an interrupt matching CHAIRQ occurs
+        }
+        uart->rxDma->registers->DCHxECONbits.CHSIRQ = uart->rxIrq; // channel transfer start IRQ
+        uart->rxDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+        if (readConditions->termination != -1) {
+            uart->rxDma->registers->DCHxECONbits.PATEN = 1; // abort transfer and clear CHEN on pattern match
+        }
+        uart->rxDma->registers->DCHxSSA = KVA_TO_PA(&uart->registers->UxRXREG); // source address
+        uart->rxDma->registers->DCHxDSA = KVA_TO_PA(uart->readData); // destination address
+        uart->rxDma->registers->DCHxSSIZ = 1; // source size
+        uart->rxDma->registers->DCHxDSIZ = readConditions->numberOfBytes > uart->readTransferSize ? uart->readTransferSize : readConditions->numberOfBytes; // destination size
+        uart->rxDma->registers->DCHxCSIZ = 1; // transfers per event
+        uart->rxDma->registers->DCHxDAT = readConditions->termination & 0xFF; // pattern data
+        uart->rxDma->registers->DCHxINTbits.CHBCIE = 1; // channel block transfer complete interrupt enable bit
+        uart->rxDma->registers->DCHxINTbits.CHTAIE = 1; // channel transfer abort interrupt enable bit
+        uart->rxDma->registers->DCHxCONbits.CHEN = 1; // channel is enabled
+
+        // Configure timer DMA channel
+        if (uart->readTimeoutPoll == false) {
+            uart->timerReset[0] = uart->timer->reset;
+            uart->timerDma->registers->DCHxCONbits.CHAEN = 1; // channel is continuously enabled, and not automatically disabled after a block transfer is complete
+            uart->timerDma->registers->DCHxECONbits.CHSIRQ = uart->rxIrq; // channel transfer start IRQ
+            uart->timerDma->registers->DCHxECONbits.SIRQEN = 1; // start channel cell transfer if an interrupt matching CHSIRQ occurs
+            uart->timerDma->registers->DCHxSSA = KVA_TO_PA(uart->timerReset); // source address
+            uart->timerDma->registers->DCHxDSA = KVA_TO_PA(uart->timer->tmrx); // destination address
+            uart->timerDma->registers->DCHxSSIZ = sizeof (uart->timerReset[0]); // source size
+            uart->timerDma->registers->DCHxDSIZ = sizeof (uart->timerReset[0]); // destination size
+            uart->timerDma->registers->DCHxCSIZ = sizeof (uart->timerReset[0]); // transfers per event
+            uart->timerDma->registers->DCHxCONbits.CHEN = 1; // channel is enabled
+        }
+    }
+
+    // Enable interrupts
+    if (uart->writeDma) {
+        EVIC_SourceEnable(uart->txDma->interruptSource);
+    }
+    if (uart->readMode == UartDmaReadModeInterrupt) {
+        EVIC_SourceEnable(uart->rxInterruptSource);
+    } else if (uart->readMode != UartDmaReadModeStream) {
+        EVIC_SourceEnable(uart->rxDma->interruptSource);
+    }
+    return UartResultOk;
+}
+
+/**
+ * @brief Initialises the UART with a read callback that also receives the
+ * time of the first byte and the time of completion of each read. The first
+ * byte is timestamped by the RX DMA channel cell transfer complete interrupt.
+ * Timestamps are not available if the read mode is interrupt or stream.
+ * @param uart UART instance.
+ * @param settings Settings.
+ * @param readConditions Read conditions.
+ * @param readTimestamped Read callback.
+ * @return Result.
+ */
+UartResult UartDmaCoreInitialiseTimestamped(UartDmaCore * const uart, const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps)) {
+    const UartResult result = UartDmaCoreInitialise(uart, settings, readConditions, NULL);
+    if ((result != UartResultOk) || (uart->readMode == UartDmaReadModeInterrupt) || (uart->readMode == UartDmaReadModeStream)) {
+        return result;
+    }
+    uart->readTimestamped = readTimestamped;
+    CaptureFirstByte(uart);
+    return UartResultOk;
+}
+
+/**
+ * @brief Sets the bridge that each read is forwarded to by the tasks. The
+ * bridge is only available if the read mode is deferred so that the
+ * destination is only written to from the main program loop.
+ * @param uart UART instance.
+ * @param bridge Bridge. NULL to disable.
+ */
+void UartDmaCoreSetBridge(UartDmaCore * const uart, const UartDmaBridge * const bridge) {
+    if (uart->readMode != UartDmaReadModeDeferred) {
+        return;
+    }
+    uart->bridge = bridge;
+    uart->bridgeData = NULL;
+}
+
+/**
+ * @brief Deinitialises the UART.
+ * @param uart UART instance.
+ */
+void UartDmaCoreDeinitialise(UartDmaCore * const uart) {
+
+    // Disable UART and restore default register states
+    uart->registers->UxMODE = 0;
+    uart->registers->UxSTA = 0;
+    UartRtsDeinitialise(&uart->rts);
+    UartRs485Deinitialise(&uart->rs485);
+
+    // Disable DMA channels and restore default register states
+    DmaFree(uart->txDma);
+    uart->txDma = NULL;
+    DmaFree(uart->rxDma);
+    uart->rxDma = NULL;
+    DmaFree(uart->timerDma);
+    uart->timerDma = NULL;
+
+    // Disable timer and restore default register states
+    UartDmaTimerFree(uart->timer);
+    uart->timer = NULL;
+
+    // Disable interrupts
+    EVIC_SourceDisable(uart->rxInterruptSource);
+    EVIC_SourceDisable(uart->txInterruptSource);
+    EVIC_SourceStatusClear(uart->rxInterruptSource);
+    EVIC_SourceStatusClear(uart->txInterruptSource);
+
+    // Clear buffers
+    uart->receiveBufferOverrun = false;
+    uart->readData = uart->readDataPing;
+    uart->readBlockPing.pending = false;
+    uart->readBlockPing.dispatched = false;
+    uart->readBlockPong.pending = false;
+    uart->readBlockPong.dispatched = false;
+    uart->readBlock = &uart->readBlockPing;
+    uart->readPaused = false;
+    uart->readTimeoutAvailable = 0;
+    UartDmaCoreClearReadBuffer(uart);
+    UartDmaCoreClearWriteBuffer(uart);
+}
+
+/**
+ * @brief Tasks. Clears the receive buffer overrun flag, dispatches read blocks
+ * to the bridge and read callbacks if the read mode is deferred, updates the
+ * software RTS if the read mode is stream, and ends reads by timeout if the
+ * read timeout is polled.
+ * @param uart UART instance.
+ */
+void UartDmaCoreTasks(UartDmaCore * const uart) {
+
+    // Clear receive buffer overrun flag
+    if (uart->registers->UxSTAbits.OERR == 1) {
+        uart->registers->UxSTACLR = _U1STA_OERR_MASK; // atomic clear so that UTXISEL writes by the TX interrupt are not lost
+        uart->receiveBufferOverrun = true;
+    }
+
+    // Dispatch read blocks in the order they were received
+    if (uart->readMode == UartDmaReadModeDeferred) {
+        while (uart->readBlock->pending) {
+            const uint8_t* const data = (uart->readBlock == &uart->readBlockPing) ? uart->readDataPing : uart->readDataPong;
+            if (uart->readBlock->dispatched == false) {
+                BridgeForward(uart, data, uart->readBlock->numberOfBytes);
+                if (uart->read != NULL) {
+                    uart->read(data, uart->readBlock->numberOfBytes);
+                }
+                if (uart->readTimestamped != NULL) {
+                    uart->readTimestamped(data, uart->readBlock->numberOfBytes, &uart->readBlock->timestamps);
+                }
+                uart->readBlock->dispatched = true;
+            }
+            if (BridgeTransferInProgress(uart, data)) {
+                break; // block released once bridge transfer complete
+            }
+            uart->readBlock->pending = false;
+            uart->readBlock->dispatched = false;
+            uart->readBlock = (uart->readBlock == &uart->readBlockPing) ? &uart->readBlockPong : &uart->readBlockPing;
+            if (uart->readPaused) {
+                ReadEnable(uart);
+            }
+        }
+    }
+
+    // Update software RTS
+    if (uart->readMode == UartDmaReadModeStream) {
+        UartDmaCoreAvailableRead(uart);
+        return;
+    }
+
+    // Do nothing else if no data available
+    if ((uart->readTimeoutPoll == false) || (uart->rxDma == NULL)) {
+        return;
+    }
+    const size_t available = uart->rxDma->registers->DCHxDPTR;
+    if (available == 0) {
+        uart->readTimeoutAvailable = 0;
+        return;
+    }
+
+    // Reset timeout if new data received
+    if (available != uart->readTimeoutAvailable) {
+        uart->readTimeoutExpiry = TimerGetTicks64() + uart->readTimeoutTicks;
+        uart->readTimeoutAvailable = available;
+        return;
+    }
+
+    // Wait for timeout
+    if (TimerGetTicks64() < uart->readTimeoutExpiry) {
+        return;
+    }
+
+    // Read
+    uart->rxDma->registers->DCHxINTbits.CHTAIF = 1; // trigger transfer abort interrupt
+    uart->readTimeoutAvailable = 0;
+}
+
+/**
+ * @brief Returns the number of bytes available in the read buffer. Only
+ * available if the read mode is interrupt or stream.
+ * @param uart UART instance.
+ * @return Number of bytes available in the read buffer.
+ */
+size_t UartDmaCoreAvailableRead(UartDmaCore * const uart) {
+    switch (uart->readMode) {
+        case UartDmaReadModeInterrupt:
+
+            // Trigger RX interrupt if receive buffer not empty
+            if (uart->registers->UxSTAbits.URXDA == 1) {
+                EVIC_SourceEnable(uart->rxInterruptSource);
+                EVIC_SourceStatusSet(uart->rxInterruptSource);
+            }
+
+            // Clear receive buffer overrun flag
+            if (uart->registers->UxSTAbits.OERR == 1) {
+                uart->registers->UxSTACLR = _U1STA_OERR_MASK; // atomic clear so that UTXISEL writes by the TX interrupt are not lost
+                uart->receiveBufferOverrun = true;
+            }
+
+            // Assert software RTS if space available
+            UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+
+            // Return number of bytes
+            return FifoPow2AvailableRead(&uart->readFifo);
+
+        case UartDmaReadModeStream:
+            if (uart->rxDma == NULL) {
+                return 0;
+            }
+            uart->readStream.writeIndex = uart->rxDma->registers->DCHxDPTR;
+            UartRtsUpdate(&uart->rts, FifoAvailableWrite(&uart->readStream));
+            return FifoAvailableRead(&uart->readStream);
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads data from the read buffer. Only available if the read mode is
+ * interrupt or stream.
+ * @param uart UART instance.
+ * @param destination Destination.
+ * @param numberOfBytes Number of bytes.
+ * @return Number of bytes read.
+ */
+size_t UartDmaCoreRead(UartDmaCore * const uart, void* const destination, size_t numberOfBytes) {
+    UartDmaCoreAvailableRead(uart); // process receive buffer or update write index
+    switch (uart->readMode) {
+        case UartDmaReadModeInterrupt:
+            numberOfBytes = FifoPow2Read(&uart->readFifo, destination, numberOfBytes);
+            UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+            return numberOfBytes;
+        case UartDmaReadModeStream:
+            numberOfBytes = FifoRead(&uart->readStream, destination, numberOfBytes);
+            UartRtsUpdate(&uart->rts, FifoAvailableWrite(&uart->readStream));
+            return numberOfBytes;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads a byte from the read buffer. This function must only be called
+ * if there are bytes available in the read buffer.
+ * @param uart UART instance.
+ * @return Byte.
+ */
+uint8_t UartDmaCoreReadByte(UartDmaCore * const uart) {
+    uint8_t byte;
+    if (uart->readMode == UartDmaReadModeInterrupt) {
+        byte = FifoPow2ReadByte(&uart->readFifo);
+        UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo));
+    } else {
+        byte = FifoReadByte(&uart->readStream);
+        UartRtsUpdate(&uart->rts, FifoAvailableWrite(&uart->readStream));
+    }
+    return byte;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer. Only available if the read mode is
+ * interrupt or stream.
+ * @param uart UART instance.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult UartDmaCoreFind(UartDmaCore * const uart, const uint8_t byte, size_t * const offset) {
+    UartDmaCoreAvailableRead(uart); // process receive buffer or update write index
+    switch (uart->readMode) {
+        case UartDmaReadModeInterrupt:
+            return FifoPow2Find(&uart->readFifo, byte, offset);
+        case UartDmaReadModeStream:
+            return FifoFind(&uart->readStream, byte, offset);
+        default:
+            return FifoResultError;
+    }
+}
+
+/**
+ * @brief Clears the read buffer. The read buffer overrun flag is also reset if
+ * the read mode is interrupt.
+ * @param uart UART instance.
+ */
+void UartDmaCoreClearReadBuffer(UartDmaCore * const uart) {
+    switch (uart->readMode) {
+        case UartDmaReadModeInterrupt:
+            FifoPow2Clear(&uart->readFifo);
+            UartDmaCoreReceiveBufferOverrun(uart); // clear flag
+            break;
+        case UartDmaReadModeStream:
+            uart->readStream.readIndex = (uart->rxDma == NULL) ? 0 : uart->rxDma->registers->DCHxDPTR;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief RX DMA channel interrupt handler. This function should be called by
+ * the handler passed to DmaAllocate by the owner of the instance.
+ * @param uart UART instance.
+ */
+void UartDmaCoreRxDmaInterruptHandler(UartDmaCore * const uart) {
+    const uint32_t ticks = TimerGetTicks32();
+    RxDmaInterruptTasks(uart);
+    const uint32_t duration = TimerGetTicks32() - ticks;
+    uart->readInterruptTicks += duration;
+    if (duration > uart->readInterruptMaxTicks) {
+        uart->readInterruptMaxTicks = duration;
+    }
+    uart->readInterrupts++;
+}
+
+/**
+ * @brief RX DMA channel interrupt tasks.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void RxDmaInterruptTasks(UartDmaCore * const uart) {
+    DmaChannel * const rxDma = uart->rxDma;
+
+    // First byte received
+    if ((rxDma->registers->DCHxINTbits.CHCCIE == 1) && (rxDma->registers->DCHxINTbits.CHCCIF == 1)) {
+        uart->firstByteTicks = TimerGetTicks64();
+        rxDma->registers->DCHxINTbits.CHCCIE = 0;
+    }
+
+    // Do nothing else if block transfer in progress
+    if ((rxDma->registers->DCHxINTbits.CHBCIF == 0) && (rxDma->registers->DCHxINTbits.CHTAIF == 0)) {
+        EVIC_SourceStatusClear(rxDma->interruptSource);
+        if ((rxDma->registers->DCHxINTbits.CHBCIF == 0) && (rxDma->registers->DCHxINTbits.CHTAIF == 0)) { // check again in case flag set before interrupt flag cleared
+            return;
+        }
+    }
+    const UartDmaReadTimestamps timestamps = {
+        .firstByte = uart->firstByteTicks,
+        .complete = TimerGetTicks64(),
+    };
+
+    // Block transfer complete or transfer aborted
+    size_t numberOfBytes = 0;
+    if (rxDma->registers->DCHxINTbits.CHBCIF == 1) {
+        numberOfBytes = BlockTransferComplete(uart);
+    } else if (rxDma->registers->DCHxINTbits.CHTAIF == 1) {
+        numberOfBytes = TransferAborted(uart);
+    }
+    rxDma->registers->DCHxINTbits.CHBCIF = 0;
+    rxDma->registers->DCHxINTbits.CHTAIF = 0;
+
+    // Queue block for tasks and re-enable channel with alternate buffer
+    if (uart->readMode == UartDmaReadModeDeferred) {
+        if (numberOfBytes > 0) {
+            UartDmaReadBlock * const block = (uart->readData == uart->readDataPing) ? &uart->readBlockPing : &uart->readBlockPong;
+            block->numberOfBytes = numberOfBytes;
+            block->timestamps = timestamps;
+            block->pending = true;
+            uart->readData = Alternate(uart, uart->readData);
+        }
+        EVIC_SourceStatusClear(rxDma->interruptSource);
+        ReadEnable(uart);
+        return;
+    }
+
+    // Re-enable channel with alternate buffer before read callback
+    const uint8_t* const data = uart->readData;
+    UartRtsDeassert(&uart->rts); // deassert software RTS while the read callback may delay the channel
+    if (uart->readMode == UartDmaReadModePingPong) {
+        uart->readData = Alternate(uart, data);
+        rxDma->registers->DCHxDSA = KVA_TO_PA(uart->readData); // destination address
+        CaptureFirstByte(uart);
+        EVIC_SourceStatusClear(rxDma->interruptSource);
+        rxDma->registers->DCHxCONbits.CHEN = 1;
+    }
+
+    // Read callbacks
+    if ((numberOfBytes > 0) && (uart->read != NULL)) {
+        uart->read(data, numberOfBytes);
+    }
+    if ((numberOfBytes > 0) && (uart->readTimestamped != NULL)) {
+        uart->readTimestamped(data, numberOfBytes, &timestamps);
+    }
+
+    // Re-enable channel after read callback
+    if (uart->readMode != UartDmaReadModePingPong) {
+        CaptureFirstByte(uart);
+        EVIC_SourceStatusClear(rxDma->interruptSource);
+        rxDma->registers->DCHxCONbits.CHEN = 1;
+    }
+    UartRtsAssert(&uart->rts);
+}
+
+/**
+ * @brief Block transfer complete.
+ * @param uart UART instance.
+ * @return Number of bytes received.
+ */
+static inline __attribute__((always_inline)) size_t BlockTransferComplete(UartDmaCore * const uart) {
+    if (uart->rxDma->registers->DCHxECONbits.PATEN == 0) {
+        return uart->rxDma->registers->DCHxDSIZ;
+    }
+    size_t numberOfBytes = 0;
+    while (numberOfBytes < uart->rxDma->registers->DCHxDSIZ) { // count number of bytes up to and including termination
+        if (uart->readData[numberOfBytes++] == uart->rxDma->registers->DCHxDAT) {
+            break;
+        }
+    }
+    return numberOfBytes;
+}
+
+/**
+ * @brief Transfer aborted.
+ * @param uart UART instance.
+ * @return Number of bytes received.
+ */
+static inline __attribute__((always_inline)) size_t TransferAborted(UartDmaCore * const uart) {
+    const size_t numberOfBytes = uart->rxDma->registers->DCHxDPTR;
+    if (numberOfBytes == 0) { // if no data received
+        return 0;
+    }
+    uart->rxDma->registers->DCHxECONbits.CABORT = 1; // reset DMA channel
+    return numberOfBytes;
+}
+
+/**
+ * @brief Returns the alternate read buffer.
+ * @param uart UART instance.
+ * @param data Read buffer.
+ * @return Alternate read buffer.
+ */
+static inline __attribute__((always_inline)) uint8_t * Alternate(UartDmaCore * const uart, const uint8_t * const data) {
+    return (data == uart->readDataPing) ? uart->readDataPong : uart->readDataPing;
+}
+
+/**
+ * @brief Enables the RX DMA channel cell transfer complete interrupt to
+ * timestamp the first byte of the next block if timestamps are used.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void CaptureFirstByte(UartDmaCore * const uart) {
+    if (uart->readTimestamped == NULL) {
+        return;
+    }
+    uart->rxDma->registers->DCHxINTbits.CHCCIF = 0;
+    uart->rxDma->registers->DCHxINTbits.CHCCIE = 1; // channel cell transfer complete interrupt enable bit
+}
+
+/**
+ * @brief Forwards a block to the bridge. Data is transferred directly from the
+ * read buffer if the bridge provides a write transfer function that is not in
+ * progress. Otherwise, data is written to the bridge write buffer. Must only be
+ * called by the tasks.
+ * @param uart UART instance.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static inline __attribute__((always_inline)) void BridgeForward(UartDmaCore * const uart, const uint8_t* const data, const size_t numberOfBytes) {
+    if (uart->bridge == NULL) {
+        return;
+    }
+    uart->bridgeData = NULL;
+    if ((uart->bridge->writeTransfer != NULL) && (uart->bridge->writeTransferInProgress() == false)) {
+        uart->bridge->writeTransfer(data, numberOfBytes, NULL); // transfer directly from read buffer
+        uart->bridgeData = data;
+        return;
+    }
+    if (uart->bridge->write != NULL) {
+        uart->bridge->write(data, numberOfBytes);
+    }
+}
+
+/**
+ * @brief Returns true if the read buffer is being transferred by the bridge.
+ * @param uart UART instance.
+ * @param data Read buffer.
+ * @return True if the read buffer is being transferred by the bridge.
+ */
+static inline __attribute__((always_inline)) bool BridgeTransferInProgress(UartDmaCore * const uart, const uint8_t* const data) {
+    return (uart->bridge != NULL) && (uart->bridgeData == data) && uart->bridge->writeTransferInProgress();
+}
+
+/**
+ * @brief Re-enables the RX DMA channel with the current buffer. The channel
+ * remains paused while the buffer is waiting to be dispatched, in which case
+ * the tasks will re-enable the channel once the buffer is dispatched.
+ * @param uart UART instance.
+ */
+static void ReadEnable(UartDmaCore * const uart) {
+    const UartDmaReadBlock * const block = (uart->readData == uart->readDataPing) ? &uart->readBlockPing : &uart->readBlockPong;
+    if (block->pending) {
+        uart->readPaused = true;
+        UartRtsDeassert(&uart->rts); // deassert software RTS while paused
+        return;
+    }
+    uart->readPaused = false;
+    UartRtsAssert(&uart->rts);
+    uart->rxDma->registers->DCHxDSA = KVA_TO_PA(uart->readData); // destination address
+    CaptureFirstByte(uart);
+    uart->rxDma->registers->DCHxCONbits.CHEN = 1;
+}
+
+/**
+ * @brief Returns the space available in the write buffer.
+ * @param uart UART instance.
+ * @return Space available in the write buffer.
+ */
+size_t UartDmaCoreAvailableWrite(UartDmaCore * const uart) {
+    if (uart->writeDma) {
+        return FifoBipAvailableWrite(&uart->writeQueue.fifo);
+    }
+    return FifoPow2AvailableWrite(&uart->writeFifo);
+}
+
+/**
+ * @brief Writes data to the write buffer.
+ * @param uart UART instance.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWrite(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes) {
+    if (uart->writeDma == false) {
+        const FifoResult result = FifoPow2Write(&uart->writeFifo, data, numberOfBytes);
+        EVIC_SourceEnable(uart->txInterruptSource);
+        return result;
+    }
+    const FifoResult result = FifoBipWrite(&uart->writeQueue.fifo, data, numberOfBytes);
+    WriteComplete(uart, &uart->writeQueue);
+    return result;
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param uart UART instance.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWritev(UartDmaCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors) {
+    if (uart->writeDma == false) {
+        const FifoResult result = FifoPow2Writev(&uart->writeFifo, vectors, numberOfVectors);
+        EVIC_SourceEnable(uart->txInterruptSource);
+        return result;
+    }
+    const FifoResult result = FifoBipWritev(&uart->writeQueue.fifo, vectors, numberOfVectors);
+    WriteComplete(uart, &uart->writeQueue);
+    return result;
+}
+
+/**
+ * @brief Writes a byte to the write buffer.
+ * @param uart UART instance.
+ * @param byte Byte.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWriteByte(UartDmaCore * const uart, const uint8_t byte) {
+    if (uart->writeDma == false) {
+        const FifoResult result = FifoPow2WriteByte(&uart->writeFifo, byte);
+        EVIC_SourceEnable(uart->txInterruptSource);
+        return result;
+    }
+    const FifoResult result = FifoBipWriteByte(&uart->writeQueue.fifo, byte);
+    WriteComplete(uart, &uart->writeQueue);
+    return result;
+}
+
+/**
+ * @brief Writes a break character to the write buffer. The UART transmits the
+ * break in place of a dummy byte written by this function. The transmitter
+ * must be idle.
+ * @param uart UART instance.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWriteBreak(UartDmaCore * const uart) {
+    if ((UartDmaCoreTransmissionComplete(uart) == false) || (UartDmaCoreAvailableWrite(uart) == 0)) {
+        return FifoResultError;
+    }
+    uart->registers->UxSTAbits.UTXBRK = 1; // send Break on next transmission
+    return UartDmaCoreWriteByte(uart, 0x00);
+}
+
+/**
+ * @brief Returns the space available in the high-priority write buffer. Only
+ * available if the TX DMA channel is used.
+ * @param uart UART instance.
+ * @return Space available in the high-priority write buffer.
+ */
+size_t UartDmaCoreAvailableWriteHighPriority(UartDmaCore * const uart) {
+    return FifoBipAvailableWrite(&uart->writeQueueHighPriority.fifo);
+}
+
+/**
+ * @brief Writes data to the high-priority write buffer. Data in the
+ * high-priority write buffer is transferred before data in the write buffer,
+ * starting from the next transfer. Only available if the TX DMA channel is
+ * used and the high-priority write buffer size is not zero.
+ * @param uart UART instance.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWriteHighPriority(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes) {
+    if (uart->writeQueueHighPriority.fifo.dataSize == 0) {
+        return FifoResultError;
+    }
+    const FifoResult result = FifoBipWrite(&uart->writeQueueHighPriority.fifo, data, numberOfBytes);
+    WriteComplete(uart, &uart->writeQueueHighPriority);
+    return result;
+}
+
+/**
+ * @brief Writes a vector of data to the high-priority write buffer. Either all
+ * or none of the data will be written. Only available if the TX DMA channel is
+ * used and the high-priority write buffer size is not zero.
+ * @param uart UART instance.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult UartDmaCoreWritevHighPriority(UartDmaCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors) {
+    if (uart->writeQueueHighPriority.fifo.dataSize == 0) {
+        return FifoResultError;
+    }
+    const FifoResult result = FifoBipWritev(&uart->writeQueueHighPriority.fifo, vectors, numberOfVectors);
+    WriteComplete(uart, &uart->writeQueueHighPriority);
+    return result;
+}
+
+/**
+ * @brief Updates the write statistics and starts a transfer if a transfer is
+ * not in progress.
+ * @param uart UART instance.
+ * @param queue Write queue.
+ */
+static void WriteComplete(UartDmaCore * const uart, UartDmaWriteQueue * const queue) {
+    const size_t depth = FifoBipAvailableRead(&queue->fifo);
+    if (depth > queue->maxDepth) {
+        queue->maxDepth = depth;
+    }
+    if ((queue->waiting == false) && (depth > 0)) {
+        queue->waitingTicks = TimerGetTicks64();
+        queue->waiting = true;
+    }
+    if (UartDmaCoreWriteTransferInProgress(uart) == false) {
+        WriteTransferComplete(uart);
+    }
+}
+
+/**
+ * @brief Discards the data transferred by the previous transfer and starts a
+ * transfer from the write buffers.
+ * @param uart UART instance.
+ */
+static void WriteTransferComplete(UartDmaCore * const uart) {
+
+    // Do nothing if not initialised or transfer already started
+    if ((uart->txDma == NULL) || UartDmaCoreWriteTransferInProgress(uart)) {
+        return;
+    }
+
+    // Discard data transferred by previous transfer
+    FifoBipReadPointerComplete(&uart->writeTransferQueue->fifo, uart->writeTransferNumberOfBytes);
+    uart->writeTransferNumberOfBytes = 0;
+
+    // Transfer data directly from high-priority write buffer, or write buffer if empty
+    UartDmaWriteQueue* queue = &uart->writeQueueHighPriority;
+    volatile void* data;
+    size_t numberOfBytes;
+    FifoBipReadPointer(&queue->fifo, &data, &numberOfBytes);
+    if (numberOfBytes == 0) {
+        queue = &uart->writeQueue;
+        FifoBipReadPointer(&queue->fifo, &data, &numberOfBytes);
+    }
+    if (numberOfBytes == 0) {
+        return;
+    }
+    if (numberOfBytes > uart->writeTransferSize) {
+        numberOfBytes = uart->writeTransferSize;
+    }
+
+    // Update latency
+    if (queue->waiting) {
+        const uint64_t ticks = TimerGetTicks64();
+        const uint32_t latency = (uint32_t) ((ticks - queue->waitingTicks) / TIMER_TICKS_PER_MICROSECOND);
+        if (latency > queue->maxLatency) {
+            queue->maxLatency = latency;
+        }
+        queue->waiting = FifoBipAvailableRead(&queue->fifo) > numberOfBytes; // remaining data continues to wait
+    }
+
+    // Start transfer
+    uart->writeTransferQueue = queue;
+    uart->writeTransferNumberOfBytes = numberOfBytes;
+    UartDmaCoreWriteTransfer(uart, (void*) data, numberOfBytes, NULL); // write buffers resumed by TX DMA channel interrupt
+}
+
+/**
+ * @brief Writes data directly to the transmit buffer through a DMA transfer.
+ * The data must be declared __attribute__((coherent)) for PIC32MZ devices. This
+ * function must not be called while a transfer is in progress. Only available
+ * if the TX DMA channel is used.
+ * @param uart UART instance.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ * @param writeTransferComplete Write transfer complete callback. NULL if
+ * unused.
+ */
+void UartDmaCoreWriteTransfer(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete) (void)) {
+    if (uart->txDma == NULL) {
+        return;
+    }
+    Rs485Transmit(uart);
+    uart->writeTransferComplete = writeTransferComplete;
+    uart->txDma->registers->DCHxSSA = KVA_TO_PA(data); // source address
+    uart->txDma->registers->DCHxSSIZ = numberOfBytes; // source size
+    uart->txDma->registers->DCHxINTbits.CHBCIF = 0; // clear TX DMA channel interrupt flag
+    uart->txDma->registers->DCHxCONbits.CHEN = 1; // enable TX DMA channel to begin write
+}
+
+/**
+ * @brief TX DMA channel interrupt handler. This function should be called by
+ * the handler passed to DmaAllocate by the owner of the instance.
+ * @param uart UART instance.
+ */
+void UartDmaCoreTxDmaInterruptHandler(UartDmaCore * const uart) {
+    EVIC_SourceStatusClear(uart->txDma->interruptSource); // clear interrupt flag first because callback may start new write
+    if (uart->writeTransferComplete != NULL) {
+        uart->writeTransferComplete();
+    }
+    WriteTransferComplete(uart); // resume write buffer if callback did not start new write
+    if (UartDmaCoreWriteTransferInProgress(uart) == false) {
+        Rs485Release(uart);
+    }
+}
+
+/**
+ * @brief Returns true while data is being transferred to the transmit buffer.
+ * @param uart UART instance.
+ * @return True while data is being transferred to the transmit buffer.
+ */
+bool UartDmaCoreWriteTransferInProgress(UartDmaCore * const uart) {
+    return (uart->txDma != NULL) && (uart->txDma->registers->DCHxCONbits.CHEN == 1);
+}
+
+/**
+ * @brief Clears the write buffer.
+ * @param uart UART instance.
+ */
+void UartDmaCoreClearWriteBuffer(UartDmaCore * const uart) {
+    if (uart->writeDma == false) {
+        FifoPow2Clear(&uart->writeFifo);
+        return;
+    }
+    FifoBipClear(&uart->writeQueue.fifo);
+    FifoBipClear(&uart->writeQueueHighPriority.fifo);
+    uart->writeQueue.waiting = false;
+    uart->writeQueueHighPriority.waiting = false;
+    uart->writeTransferQueue = &uart->writeQueue;
+    uart->writeTransferNumberOfBytes = 0;
+}
+
+/**
+ * @brief Gets the write statistics. The maximum values are reset each time
+ * this function is called. Only available if the TX DMA channel is used.
+ * @param uart UART instance.
+ * @param statistics Write buffer statistics.
+ * @param highPriorityStatistics High-priority write buffer statistics.
+ */
+void UartDmaCoreGetWriteStatistics(UartDmaCore * const uart, UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics) {
+    GetWriteStatistics(&uart->writeQueue, statistics);
+    GetWriteStatistics(&uart->writeQueueHighPriority, highPriorityStatistics);
+}
+
+/**
+ * @brief Gets the write statistics of a write queue.
+ * @param queue Write queue.
+ * @param statistics Statistics.
+ */
+static void GetWriteStatistics(UartDmaWriteQueue * const queue, UartDmaWriteStatistics * const statistics) {
+    statistics->depth = FifoBipAvailableRead(&queue->fifo);
+    statistics->maxDepth = queue->maxDepth;
+    statistics->maxLatency = queue->maxLatency;
+    queue->maxDepth = 0;
+    queue->maxLatency = 0;
+}
+
+/**
+ * @brief Gets the RX DMA channel interrupt statistics since the previous call.
+ * Statistics are not available if the read mode is interrupt or stream, or if
+ * no time has elapsed since the previous call.
+ * @param uart UART instance.
+ * @param statistics Statistics.
+ */
+void UartDmaCoreGetReadInterruptStatistics(UartDmaCore * const uart, UartDmaReadInterruptStatistics * const statistics) {
+    const uint64_t ticks = TimerGetTicks64();
+    if ((uart->readMode == UartDmaReadModeInterrupt) || (uart->readMode == UartDmaReadModeStream) || (ticks == uart->statisticsTicks)) {
+        statistics->interruptsPerSecond = 0.0f;
+        statistics->averageDuration = 0.0f;
+        statistics->maxDuration = 0.0f;
+        return;
+    }
+
+    // Calculate elapsed time
+    const float seconds = (float) (ticks - uart->statisticsTicks) / (float) TIMER_TICKS_PER_SECOND;
+    uart->statisticsTicks = ticks;
+
+    // Calculate statistics
+    const uint32_t interrupts = uart->readInterrupts - uart->readInterruptsPrevious;
+    const uint32_t interruptTicks = uart->readInterruptTicks - uart->readInterruptTicksPrevious;
+    uart->readInterruptsPrevious += interrupts;
+    uart->readInterruptTicksPrevious += interruptTicks;
+    statistics->interruptsPerSecond = (float) interrupts / seconds;
+    statistics->averageDuration = interrupts == 0 ? 0.0f : ((float) interruptTicks / (float) interrupts) / (float) TIMER_TICKS_PER_MICROSECOND;
+    statistics->maxDuration = (float) uart->readInterruptMaxTicks / (float) TIMER_TICKS_PER_MICROSECOND;
+    uart->readInterruptMaxTicks = 0;
+}
+
+/**
+ * @brief Returns true if the receive buffer has overrun. Calling this function
+ * will reset the flag.
+ * @param uart UART instance.
+ * @return True if the receive buffer has overrun.
+ */
+bool UartDmaCoreReceiveBufferOverrun(UartDmaCore * const uart) {
+    if (uart->receiveBufferOverrun) {
+        uart->receiveBufferOverrun = false;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns true if all data has been transmitted.
+ * @param uart UART instance.
+ * @return True if all data has been transmitted.
+ */
+bool UartDmaCoreTransmissionComplete(UartDmaCore * const uart) {
+    if (uart->writeDma) {
+        return (UartDmaCoreWriteTransferInProgress(uart) == false) && (uart->registers->UxSTAbits.TRMT == 1);
+    }
+    return (EVIC_SourceIsEnabled(uart->txInterruptSource) == false) && (uart->registers->UxSTAbits.TRMT == 1);
+}
+
+/**
+ * @brief Starts auto-baud. The baud rate is measured from the next character
+ * received, which must be 0x55 ('U'). The measurement resolution is that of
+ * the BRGH value selected for the initial baud rate. The read buffer should be
+ * cleared once auto-baud is complete.
+ * @param uart UART instance.
+ */
+void UartDmaCoreStartAutoBaud(UartDmaCore * const uart) {
+    uart->registers->UxMODEbits.ABAUD = 1; // enable baud rate measurement on the next character (requires reception of a Sync field (55h))
+}
+
+/**
+ * @brief Returns true while auto-baud is in progress.
+ * @param uart UART instance.
+ * @return True while auto-baud is in progress.
+ */
+bool UartDmaCoreAutoBaudInProgress(UartDmaCore * const uart) {
+    return uart->registers->UxMODEbits.ABAUD == 1;
+}
+
+/**
+ * @brief Returns the actual baud rate. This may be used to obtain the baud
+ * rate measured by auto-baud.
+ * @param uart UART instance.
+ * @return Baud rate.
+ */
+float UartDmaCoreGetBaudRate(UartDmaCore * const uart) {
+    return UartCalculateActualBaudRate(uart->registers->UxMODEbits.BRGH == 1, uart->registers->UxBRG);
+}
+
+/**
+ * @brief UART RX and TX interrupt handler for devices with a single UART
+ * interrupt vector.
+ * @param uart UART instance.
+ */
+void UartDmaCoreInterruptHandler(UartDmaCore * const uart) {
+
+    // RX interrupt
+    if ((uart->readMode == UartDmaReadModeInterrupt) && EVIC_SourceStatusGet(uart->rxInterruptSource)) {
+        RxInterruptTasks(uart);
+    }
+
+    // TX interrupt
+    if (EVIC_SourceIsEnabled(uart->txInterruptSource) == false) {
+        return; // return if TX interrupt disabled because TX interrupt flag will remain set while the transmit buffer is empty
+    }
+    if (EVIC_SourceStatusGet(uart->txInterruptSource)) {
+        TxInterruptTasks(uart);
+    }
+}
+
+/**
+ * @brief UART RX interrupt handler for devices with separate UART RX and TX
+ * interrupt vectors.
+ * @param uart UART instance.
+ */
+void UartDmaCoreRxInterruptHandler(UartDmaCore * const uart) {
+    RxInterruptTasks(uart);
+}
+
+/**
+ * @brief UART TX interrupt handler for devices with separate UART RX and TX
+ * interrupt vectors.
+ * @param uart UART instance.
+ */
+void UartDmaCoreTxInterruptHandler(UartDmaCore * const uart) {
+    TxInterruptTasks(uart);
+}
+
+/**
+ * @brief UART RX interrupt tasks. Only used if the read mode is interrupt.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void RxInterruptTasks(UartDmaCore * const uart) {
+    while (uart->registers->UxSTAbits.URXDA == 1) { // while data available in receive buffer
+        volatile void* pointer;
+        size_t numberOfBytes;
+        FifoPow2WritePointer(&uart->readFifo, &pointer, &numberOfBytes);
+        if (numberOfBytes == 0) { // if read buffer full
+            EVIC_SourceDisable(uart->rxInterruptSource);
+            break;
+        }
+        volatile uint8_t * const destination = pointer;
+        size_t index = 0;
+        while ((uart->registers->UxSTAbits.URXDA == 1) && (index < numberOfBytes)) { // write directly to read buffer
+            destination[index++] = uart->registers->UxRXREG;
+        }
+        FifoPow2WritePointerComplete(&uart->readFifo, index);
+    }
+    UartRtsUpdate(&uart->rts, FifoPow2AvailableWrite(&uart->readFifo)); // deassert software RTS if space below watermark
+    EVIC_SourceStatusClear(uart->rxInterruptSource);
+}
+
+/**
+ * @brief UART TX interrupt tasks. If the TX DMA channel is used then the TX
+ * interrupt is only used to release the RS-485 driver enable.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void TxInterruptTasks(UartDmaCore * const uart) {
+    EVIC_SourceDisable(uart->txInterruptSource); // disable TX interrupt to avoid nested interrupt
+    EVIC_SourceStatusClear(uart->txInterruptSource);
+    if (uart->writeDma) {
+        if (UartDmaCoreWriteTransferInProgress(uart)) {
+            return; // released once write transfer complete
+        }
+        Rs485Release(uart);
+        return;
+    }
+    if (FifoPow2AvailableRead(&uart->writeFifo) > 0) {
+        Rs485Transmit(uart);
+    }
+    while (uart->registers->UxSTAbits.UTXBF == 0) { // while transmit buffer not full
+        if (FifoPow2AvailableRead(&uart->writeFifo) == 0) { // if write buffer empty
+            Rs485Release(uart);
+            return;
+        }
+        uart->registers->UxTXREG = FifoPow2ReadByte(&uart->writeFifo);
+    }
+    EVIC_SourceEnable(uart->txInterruptSource); // re-enable TX interrupt
+}
+
+/**
+ * @brief Asserts the RS-485 driver enable before data is written to the
+ * transmit buffer. UTXISEL is not modified if the RS-485 driver enable is not
+ * used.
+ * @param uart UART instance.
+ */
+static inline __attribute__((always_inline)) void Rs485Transmit(UartDmaCore * const uart) {
+    if (uart->rs485.enabled == false) {
+        return;
+    }
+    if (uart->writeDma) {
+        EVIC_SourceDisable(uart->txInterruptSource);
+        uart->registers->UxSTAbits.UTXISEL = 0b00; // interrupt is generated and asserted while the transmit buffer contains at least one empty space
+    } else {
+        uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+    }
+    UartRs485Transmit(&uart->rs485);
+}
+
+/**
+ * @brief Releases the RS-485 driver enable if all characters have been
+ * transmitted. Otherwise, the TX interrupt is enabled to be generated when all
+ * characters have been transmitted. UTXISEL is not modified and the TX
+ * interrupt is not enabled if the RS-485 driver enable is not used.
+ * @param uart UART instance.
+ */
+static void Rs485Release(UartDmaCore * const uart) {
+    if (uart->rs485.enabled == false) {
+        return;
+    }
+    if (uart->registers->UxSTAbits.TRMT == 1) {
+        if (uart->writeDma == false) {
+            uart->registers->UxSTAbits.UTXISEL = 0b10; // interrupt is generated and asserted while the transmit buffer is empty
+        }
+        UartRs485Receive(&uart->rs485);
+        return;
+    }
+    uart->registers->UxSTAbits.UTXISEL = 0b01; // interrupt is generated and asserted when all characters have been transmitted
+    EVIC_SourceStatusClear(uart->txInterruptSource);
+    EVIC_SourceEnable(uart->txInterruptSource);
+    if (uart->registers->UxSTAbits.TRMT == 1) {
+        EVIC_SourceStatusSet(uart->txInterruptSource); // in case all characters were transmitted before interrupt was enabled
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
@@ -0,0 +1,159 @@
+/**
+ * @file UartDmaCore.h
+ * @author Seb Madgwick
+ * @brief UART driver using DMA for PIC32 devices. A single implementation
+ * shared by all UART instances and DMA variants. Each instance is described by
+ * a UartDmaCore structure.
+ */
+
+#ifndef UART_DMA_CORE_H
+#define UART_DMA_CORE_H
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "definitions.h"
+#include "Dma/Dma.h"
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Uart.h"
+#include "UartDma.h"
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Read mode.
+ */
+typedef enum {
+    UartDmaReadModeInterrupt, // no RX DMA channel, RX interrupt writes to read FIFO
+    UartDmaReadModeBlock, // RX DMA channel re-enabled after read callback
+    UartDmaReadModePingPong, // RX DMA channel re-enabled with alternate buffer before read callback
+    UartDmaReadModeDeferred, // blocks dispatched by tasks
+    UartDmaReadModeStream, // RX DMA channel writes to read buffer continuously
+} UartDmaReadMode;
+
+/**
+ * @brief Write queue. The FIFO must be initialised by the owner of the
+ * instance. All other structure members are private.
+ */
+typedef struct {
+    FifoBip fifo;
+    bool waiting;
+    uint64_t waitingTicks;
+    size_t maxDepth;
+    uint32_t maxLatency;
+} UartDmaWriteQueue;
+
+/**
+ * @brief Read block waiting to be dispatched by the tasks.
+ */
+typedef struct {
+    size_t numberOfBytes;
+    UartDmaReadTimestamps timestamps;
+    volatile bool pending;
+    bool dispatched;
+} UartDmaReadBlock;
+
+/**
+ * @brief UART instance. The members up to and including the write transfer
+ * size must be initialised by the owner of the instance. Members not used by
+ * the read mode or write method may be left zero. The read buffers and timer
+ * reset value must be declared __attribute__((coherent)) for PIC32MZ devices.
+ * All other structure members are private.
+ */
+typedef struct {
+    UartRegisters * const registers;
+    const INT_SOURCE rxInterruptSource;
+    const INT_SOURCE txInterruptSource;
+    const int rxIrq;
+    const int txIrq;
+    const UartDmaReadMode readMode;
+    const bool readTimeoutPoll;
+    const bool writeDma;
+    void (*const rxDmaInterruptHandler) (void);
+    void (*const txDmaInterruptHandler) (void);
+    uint8_t * const readDataPing;
+    uint8_t * const readDataPong;
+    const size_t readTransferSize;
+    uint32_t * const timerReset;
+    FifoPow2 readFifo;
+    Fifo readStream;
+    FifoPow2 writeFifo;
+    UartDmaWriteQueue writeQueue;
+    UartDmaWriteQueue writeQueueHighPriority;
+    const size_t writeTransferSize;
+    DmaChannel* txDma;
+    DmaChannel* rxDma;
+    DmaChannel* timerDma;
+    UartDmaTimer* timer;
+    uint64_t readTimeoutTicks;
+    uint64_t readTimeoutExpiry;
+    size_t readTimeoutAvailable;
+    bool receiveBufferOverrun;
+    UartRts rts;
+    UartRs485 rs485;
+    void (*read)(const void* const data, const size_t numberOfBytes);
+    void (*readTimestamped)(const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps);
+    uint64_t firstByteTicks;
+    const UartDmaBridge* bridge;
+    const uint8_t* bridgeData;
+    volatile uint32_t readInterrupts;
+    volatile uint32_t readInterruptTicks;
+    volatile uint32_t readInterruptMaxTicks;
+    uint32_t readInterruptsPrevious;
+    uint32_t readInterruptTicksPrevious;
+    uint64_t statisticsTicks;
+    uint8_t* readData;
+    UartDmaReadBlock readBlockPing;
+    UartDmaReadBlock readBlockPong;
+    UartDmaReadBlock* readBlock;
+    volatile bool readPaused;
+    UartDmaWriteQueue* writeTransferQueue;
+    size_t writeTransferNumberOfBytes;
+    void (*writeTransferComplete)(void);
+} UartDmaCore;
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+UartResult UartDmaCoreInitialise(UartDmaCore * const uart, const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const read) (const void* const data, const size_t numberOfBytes));
+UartResult UartDmaCoreInitialiseTimestamped(UartDmaCore * const uart, const UartSettings * const settings, const UartDmaReadConditions * const readConditions, void (*const readTimestamped) (const void* const data, const size_t numberOfBytes, const UartDmaReadTimestamps * const timestamps));
+void UartDmaCoreSetBridge(UartDmaCore * const uart, const UartDmaBridge * const bridge);
+void UartDmaCoreDeinitialise(UartDmaCore * const uart);
+void UartDmaCoreTasks(UartDmaCore * const uart);
+size_t UartDmaCoreAvailableRead(UartDmaCore * const uart);
+size_t UartDmaCoreRead(UartDmaCore * const uart, void* const destination, size_t numberOfBytes);
+uint8_t UartDmaCoreReadByte(UartDmaCore * const uart);
+FifoResult UartDmaCoreFind(UartDmaCore * const uart, const uint8_t byte, size_t * const offset);
+void UartDmaCoreClearReadBuffer(UartDmaCore * const uart);
+size_t UartDmaCoreAvailableWrite(UartDmaCore * const uart);
+FifoResult UartDmaCoreWrite(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes);
+FifoResult UartDmaCoreWritev(UartDmaCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors);
+FifoResult UartDmaCoreWriteByte(UartDmaCore * const uart, const uint8_t byte);
+FifoResult UartDmaCoreWriteBreak(UartDmaCore * const uart);
+size_t UartDmaCoreAvailableWriteHighPriority(UartDmaCore * const uart);
+FifoResult UartDmaCoreWriteHighPriority(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes);
+FifoResult UartDmaCoreWritevHighPriority(UartDmaCore * const uart, const FifoVector * const vectors, const size_t numberOfVectors);
+void UartDmaCoreWriteTransfer(UartDmaCore * const uart, const void* const data, const size_t numberOfBytes, void (*const writeTransferComplete) (void));
+bool UartDmaCoreWriteTransferInProgress(UartDmaCore * const uart);
+void UartDmaCoreClearWriteBuffer(UartDmaCore * const uart);
+void UartDmaCoreGetWriteStatistics(UartDmaCore * const uart, UartDmaWriteStatistics * const statistics, UartDmaWriteStatistics * const highPriorityStatistics);
+void UartDmaCoreGetReadInterruptStatistics(UartDmaCore * const uart, UartDmaReadInterruptStatistics * const statistics);
+bool UartDmaCoreReceiveBufferOverrun(UartDmaCore * const uart);
+bool UartDmaCoreTransmissionComplete(UartDmaCore * const uart);
+void UartDmaCoreStartAutoBaud(UartDmaCore * const uart);
+bool UartDmaCoreAutoBaudInProgress(UartDmaCore * const uart);
+float UartDmaCoreGetBaudRate(UartDmaCore * const uart);
+void UartDmaCoreRxDmaInterruptHandler(UartDmaCore * const uart);
+void UartDmaCoreTxDmaInterruptHandler(UartDmaCore * const uart);
+void UartDmaCoreInterruptHandler(UartDmaCore * const uart);
+void UartDmaCoreRxInterruptHandler(UartDmaCore * const uart);
+void UartDmaCoreTxInterruptHandler(UartDmaCore * const uart);
+
+#endif
+
+//------------------------------------------------------------------------------
+// End of file
@@ -11,6 +11,14 @@
 #include "definitions.h"
 #include "UsbCdc.h"
 
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum write transfer size.
+ */
+#define MAX_WRITE_TRANSFER_SIZE (1024)
+
 //------------------------------------------------------------------------------
 // Function declarations
 
@@ -30,8 +38,9 @@ static volatile bool readInProgress;
 static volatile bool writeInProgress;
 static uint8_t readData[USB_CDC_READ_BUFFER_SIZE];
 static Fifo readFifo = {.data = readData, .dataSize = sizeof (readData)};
-static uint8_t writeData[USB_CDC_WRITE_BUFFER_SIZE];
-static Fifo writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+static uint8_t __attribute__((coherent)) writeData[USB_CDC_WRITE_BUFFER_SIZE]; // must be declared __attribute__((coherent)) for PIC32MZ devices
+static FifoBip writeFifo = {.data = writeData, .dataSize = sizeof (writeData)};
+static size_t writeTransferSize;
 
 //------------------------------------------------------------------------------
 // Functions
@@ -163,23 +172,30 @@ static void WriteTasks(void) {
         return;
     }
 
+    // Discard data written by previous write
+    FifoBipReadPointerComplete(&writeFifo, writeTransferSize);
+    writeTransferSize = 0;
+
     // Do nothing if no data available
-    if (FifoAvailableRead(&writeFifo) == 0) {
+    volatile void* data;
+    size_t numberOfBytes;
+    FifoBipReadPointer(&writeFifo, &data, &numberOfBytes);
+    if (numberOfBytes == 0) {
         return;
     }
+    if (numberOfBytes > MAX_WRITE_TRANSFER_SIZE) {
+        numberOfBytes = MAX_WRITE_TRANSFER_SIZE;
+    }
 
-    // Copy data to buffer
-    static uint8_t __attribute__((coherent)) buffer[1024]; // must be declared __attribute__((coherent)) for PIC32MZ devices
-    const size_t numberOfBytes = FifoRead(&writeFifo, buffer, sizeof (buffer));
-
-    // Schedule write
+    // Schedule write directly from write buffer
     writeInProgress = true;
     static USB_DEVICE_CDC_TRANSFER_HANDLE usbDeviceCdcTransferHandle = USB_DEVICE_CDC_TRANSFER_HANDLE_INVALID;
-    const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, buffer, numberOfBytes, USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE);
+    const USB_DEVICE_CDC_RESULT usbDeviceCdcResult = USB_DEVICE_CDC_Write(USB_DEVICE_CDC_INDEX_0, &usbDeviceCdcTransferHandle, (void*) data, numberOfBytes, USB_DEVICE_CDC_TRANSFER_FLAGS_DATA_COMPLETE);
     if (usbDeviceCdcResult != USB_DEVICE_CDC_RESULT_OK) {
         writeInProgress = false;
         return;
     }
+    writeTransferSize = numberOfBytes;
 }
 
 /**
@@ -230,6 +246,17 @@ size_t UsbCdcRead(void* const destination, size_t numberOfBytes) {
     return FifoRead(&readFifo, destination, numberOfBytes);
 }
 
+/**
+ * @brief Finds the first occurrence of a byte in the read buffer. The data is
+ * not removed from the read buffer.
+ * @param byte Byte.
+ * @param offset Offset of the byte from the next byte to be read.
+ * @return Result.
+ */
+FifoResult UsbCdcFind(const uint8_t byte, size_t * const offset) {
+    return FifoFind(&readFifo, byte, offset);
+}
+
 /**
  * @brief Reads a byte from the read buffer. This function must only be called
  * if there are bytes available in the read buffer.
@@ -244,7 +271,7 @@ uint8_t UsbCdcReadByte(void) {
  * @return Space available in the write buffer.
  */
 size_t UsbCdcAvailableWrite(void) {
-    return FifoAvailableWrite(&writeFifo);
+    return FifoBipAvailableWrite(&writeFifo);
 }
 
 /**
@@ -254,7 +281,18 @@ size_t UsbCdcAvailableWrite(void) {
  * @return Result.
  */
 FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes) {
-    return FifoWrite(&writeFifo, data, numberOfBytes);
+    return FifoBipWrite(&writeFifo, data, numberOfBytes);
+}
+
+/**
+ * @brief Writes a vector of data to the write buffer. Either all or none of the
+ * data will be written.
+ * @param vectors Vectors.
+ * @param numberOfVectors Number of vectors.
+ * @return Result.
+ */
+FifoResult UsbCdcWritev(const FifoVector * const vectors, const size_t numberOfVectors) {
+    return FifoBipWritev(&writeFifo, vectors, numberOfVectors);
 }
 
 /**
@@ -263,7 +301,7 @@ FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes) {
  * @return Result.
  */
 FifoResult UsbCdcWriteByte(const uint8_t byte) {
-    return FifoWriteByte(&writeFifo, byte);
+    return FifoBipWriteByte(&writeFifo, byte);
 }
 
 //------------------------------------------------------------------------------
@@ -25,8 +25,10 @@ bool UsbCdcPortOpen(void);
 size_t UsbCdcAvailableRead(void);
 size_t UsbCdcRead(void* const destination, size_t numberOfBytes);
 uint8_t UsbCdcReadByte(void);
+FifoResult UsbCdcFind(const uint8_t byte, size_t * const offset);
 size_t UsbCdcAvailableWrite(void);
 FifoResult UsbCdcWrite(const void* const data, const size_t numberOfBytes);
+FifoResult UsbCdcWritev(const FifoVector * const vectors, const size_t numberOfVectors);
 FifoResult UsbCdcWriteByte(const uint8_t byte);
 
 #endif
@@ -0,0 +1,253 @@
+/**
+ * @file FifoBenchmark.c
+ * @author Seb Madgwick
+ * @brief Host-side throughput benchmark for Fifo.h. Each benchmark transfers
+ * data through the FIFO for a range of sizes and initial index positions and
+ * prints the throughput in megabytes per second. Results are a baseline for
+ * comparing FIFO changes and are not representative of PIC32 performance.
+ *
+ * Build and run from this directory:
+ * gcc -std=c99 -O2 -Wall -Wextra -I.. FifoBenchmark.c -o FifoBenchmark && ./FifoBenchmark
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#define _POSIX_C_SOURCE 199309L
+#include "Fifo.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Number of bytes transferred by each benchmark.
+ */
+#define NUMBER_OF_BYTES (64UL * 1024UL * 1024UL)
+
+/**
+ * @brief Maximum FIFO data size.
+ */
+#define MAX_DATA_SIZE (4096)
+
+/**
+ * @brief Benchmark function.
+ */
+typedef void (*Benchmark)(const size_t dataSize, const size_t offset, const size_t chunkSize);
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static double Seconds(void);
+static void Run(const char* const name, const Benchmark benchmark, const size_t chunkSize);
+static void WriteRead(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void WriteByteReadByte(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void WritePacketReadPackets(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void WriteReadPointer(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void Pow2WriteRead(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void Pow2WriteByteReadByte(const size_t dataSize, const size_t offset, const size_t chunkSize);
+static void BipWriteReadPointer(const size_t dataSize, const size_t offset, const size_t chunkSize);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint8_t fifoData[MAX_DATA_SIZE];
+static uint8_t source[MAX_DATA_SIZE];
+static uint8_t destination[MAX_DATA_SIZE];
+static volatile uint32_t sink; // prevents reads being optimised away
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs all benchmarks.
+ * @return 0.
+ */
+int main(void) {
+    for (size_t index = 0; index < sizeof (source); index++) {
+        source[index] = (uint8_t) index;
+    }
+    printf("%-24s %6s %6s %6s %10s\n", "Benchmark", "Size", "Offset", "Chunk", "MB/s");
+    Run("FifoWrite/FifoRead", WriteRead, 64);
+    Run("FifoWrite/FifoRead", WriteRead, 512);
+    Run("FifoWriteByte/ReadByte", WriteByteReadByte, 64);
+    Run("FifoWritePacket/Packets", WritePacketReadPackets, 64);
+    Run("FifoWrite/ReadPointer", WriteReadPointer, 64);
+    Run("FifoWrite/ReadPointer", WriteReadPointer, 512);
+    Run("FifoPow2Write/Read", Pow2WriteRead, 64);
+    Run("FifoPow2Write/Read", Pow2WriteRead, 512);
+    Run("FifoPow2WriteByte/Byte", Pow2WriteByteReadByte, 64);
+    Run("FifoBipWrite/ReadPointer", BipWriteReadPointer, 64);
+    Run("FifoBipWrite/ReadPointer", BipWriteReadPointer, 512);
+    return 0;
+}
+
+/**
+ * @brief Returns the monotonic time.
+ * @return Time in seconds.
+ */
+static double Seconds(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + ((double) time.tv_nsec * 1E-9);
+}
+
+/**
+ * @brief Runs a benchmark for each size and initial index position and prints
+ * the throughput.
+ * @param name Name.
+ * @param benchmark Benchmark.
+ * @param chunkSize Number of bytes written and read by each operation.
+ */
+static void Run(const char* const name, const Benchmark benchmark, const size_t chunkSize) {
+    static const size_t dataSizes[] = {1024, 4096};
+    for (size_t sizeIndex = 0; sizeIndex < (sizeof (dataSizes) / sizeof (dataSizes[0])); sizeIndex++) {
+        const size_t dataSize = dataSizes[sizeIndex];
+        const size_t offsets[] = {0, dataSize / 2, dataSize - (chunkSize / 2)};
+        for (size_t offsetIndex = 0; offsetIndex < (sizeof (offsets) / sizeof (offsets[0])); offsetIndex++) {
+            const double start = Seconds();
+            benchmark(dataSize, offsets[offsetIndex], chunkSize);
+            const double seconds = Seconds() - start;
+            printf("%-24s %6zu %6zu %6zu %10.1f\n", name, dataSize, offsets[offsetIndex], chunkSize, ((double) NUMBER_OF_BYTES / seconds) / 1E6);
+        }
+    }
+}
+
+/**
+ * @brief FifoWrite and FifoRead.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each operation.
+ */
+static void WriteRead(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += (2 * chunkSize)) {
+        FifoWrite(&fifo, source, chunkSize);
+        FifoWrite(&fifo, source, chunkSize);
+        FifoRead(&fifo, destination, chunkSize);
+        FifoRead(&fifo, destination, chunkSize);
+        sink += destination[0];
+    }
+}
+
+/**
+ * @brief FifoWriteByte and FifoReadByte loops.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each loop.
+ */
+static void WriteByteReadByte(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += chunkSize) {
+        for (size_t index = 0; index < chunkSize; index++) {
+            FifoWriteByte(&fifo, source[index]);
+        }
+        uint32_t sum = 0;
+        while (FifoAvailableRead(&fifo) > 0) {
+            sum += FifoReadByte(&fifo);
+        }
+        sink += sum;
+    }
+}
+
+/**
+ * @brief FifoWritePacket and FifoReadPackets. Four packets are written for
+ * each read.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written by each group of packets.
+ */
+static void WritePacketReadPackets(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    const size_t packetSize = chunkSize / 4;
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += chunkSize) {
+        for (int packet = 0; packet < 4; packet++) {
+            FifoWritePacket(&fifo, source, packetSize);
+        }
+        FifoReadPackets(&fifo, destination, sizeof (destination));
+        sink += destination[0];
+    }
+}
+
+/**
+ * @brief FifoWrite and zero-copy FifoReadPointer.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each operation.
+ */
+static void WriteReadPointer(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += chunkSize) {
+        FifoWrite(&fifo, source, chunkSize);
+        while (FifoAvailableRead(&fifo) > 0) {
+            volatile void* pointer;
+            size_t numberOfBytes;
+            FifoReadPointer(&fifo, &pointer, &numberOfBytes);
+            sink += ((volatile uint8_t*) pointer)[numberOfBytes - 1];
+            FifoReadPointerComplete(&fifo, numberOfBytes);
+        }
+    }
+}
+
+/**
+ * @brief FifoPow2Write and FifoPow2Read.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each operation.
+ */
+static void Pow2WriteRead(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    FifoPow2 fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += (2 * chunkSize)) {
+        FifoPow2Write(&fifo, source, chunkSize);
+        FifoPow2Write(&fifo, source, chunkSize);
+        FifoPow2Read(&fifo, destination, chunkSize);
+        FifoPow2Read(&fifo, destination, chunkSize);
+        sink += destination[0];
+    }
+}
+
+/**
+ * @brief FifoPow2WriteByte and FifoPow2ReadByte loops.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each loop.
+ */
+static void Pow2WriteByteReadByte(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    FifoPow2 fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += chunkSize) {
+        for (size_t index = 0; index < chunkSize; index++) {
+            FifoPow2WriteByte(&fifo, source[index]);
+        }
+        uint32_t sum = 0;
+        while (FifoPow2AvailableRead(&fifo) > 0) {
+            sum += FifoPow2ReadByte(&fifo);
+        }
+        sink += sum;
+    }
+}
+
+/**
+ * @brief FifoBipWrite and zero-copy FifoBipReadPointer.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param chunkSize Number of bytes written and read by each operation.
+ */
+static void BipWriteReadPointer(const size_t dataSize, const size_t offset, const size_t chunkSize) {
+    FifoBip fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset, .endIndex = dataSize};
+    for (size_t count = 0; count < NUMBER_OF_BYTES; count += chunkSize) {
+        FifoBipWrite(&fifo, source, chunkSize);
+        while (FifoBipAvailableRead(&fifo) > 0) {
+            volatile void* pointer;
+            size_t numberOfBytes;
+            FifoBipReadPointer(&fifo, &pointer, &numberOfBytes);
+            sink += ((volatile uint8_t*) pointer)[numberOfBytes - 1];
+            FifoBipReadPointerComplete(&fifo, numberOfBytes);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file
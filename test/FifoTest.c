@@ -0,0 +1,785 @@
+/**
+ * @file FifoTest.c
+ * @author Seb Madgwick
+ * @brief Host-side correctness tests for Fifo.h. Each test interleaves the
+ * producer and consumer operations in a random order and checks the data
+ * stream against a reference byte sequence. Each test is repeated for a range
+ * of sizes and initial index positions so that every wraparound path is
+ * exercised.
+ *
+ * Build and run from this directory:
+ * gcc -std=c99 -O2 -Wall -Wextra -I.. FifoTest.c -o FifoTest && ./FifoTest
+ */
+
+//------------------------------------------------------------------------------
+// Includes
+
+#include "Fifo.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------------
+// Definitions
+
+/**
+ * @brief Maximum data size.
+ */
+#define MAX_DATA_SIZE (4096)
+
+/**
+ * @brief Number of random operations per test.
+ */
+#define NUMBER_OF_OPERATIONS (20000)
+
+/**
+ * @brief Number of broadcast FIFO readers.
+ */
+#define NUMBER_OF_BROADCAST_READERS (3)
+
+/**
+ * @brief Typed FIFO capacity.
+ */
+#define TYPED_FIFO_CAPACITY (16)
+
+/**
+ * @brief Checks a condition and reports the failure location.
+ */
+#define CHECK(condition) Check((condition), #condition, __FILE__, __LINE__)
+
+/**
+ * @brief Reference stream. Byte n of the stream is a function of n so that the
+ * consumer can verify every byte without storing a copy of the data.
+ */
+typedef struct {
+    uint64_t written;
+    uint64_t read;
+} Stream;
+
+/**
+ * @brief Typed FIFO of stream indexes.
+ */
+FIFO_TYPED(TypedFifo, uint64_t, TYPED_FIFO_CAPACITY)
+
+//------------------------------------------------------------------------------
+// Function declarations
+
+static void Check(const bool condition, const char* const expression, const char* const file, const int line);
+static uint32_t Random(void);
+static uint8_t StreamByte(const uint64_t index);
+static void StreamFill(Stream * const stream, uint8_t * const data, const size_t numberOfBytes);
+static void StreamVerify(Stream * const stream, const uint8_t * const data, const size_t numberOfBytes);
+static void TestFifo(const size_t dataSize, const size_t offset);
+static void TestFifoPacket(const size_t dataSize, const size_t offset);
+static void TestFifoPow2(const size_t dataSize, const size_t offset);
+static void TestFifoBip(const size_t dataSize, const size_t offset);
+static void TestFifoMultiProducer(const size_t dataSize, const size_t offset);
+static void TestFifoBroadcast(const size_t dataSize, const size_t offset, const bool dropSlowReaders);
+static void TestFifoBroadcastWrite(FifoBroadcast * const fifo, Stream * const stream, Stream * const readers, bool * const dropped, const size_t numberOfBytes);
+static void TestFifoBroadcastResynchronise(Stream * const stream, Stream * const reader, bool * const dropped, uint32_t * const numberOfDrops);
+static void TestTypedFifo(const size_t offset);
+
+//------------------------------------------------------------------------------
+// Variables
+
+static uint32_t randomState = 1;
+static uint32_t numberOfChecks;
+static uint32_t numberOfFailures;
+
+//------------------------------------------------------------------------------
+// Functions
+
+/**
+ * @brief Runs all tests.
+ * @return 0 if all tests passed.
+ */
+int main(void) {
+    static const size_t dataSizes[] = {2, 3, 16, 17, 64, 1000, 4096};
+    for (size_t sizeIndex = 0; sizeIndex < (sizeof (dataSizes) / sizeof (dataSizes[0])); sizeIndex++) {
+        const size_t dataSize = dataSizes[sizeIndex];
+        const size_t offsets[] = {0, 1, dataSize / 2, dataSize - 2, dataSize - 1};
+        for (size_t offsetIndex = 0; offsetIndex < (sizeof (offsets) / sizeof (offsets[0])); offsetIndex++) {
+            TestFifo(dataSize, offsets[offsetIndex]);
+            TestFifoBip(dataSize, offsets[offsetIndex]);
+            TestFifoMultiProducer(dataSize, offsets[offsetIndex]);
+            TestFifoBroadcast(dataSize, offsets[offsetIndex], false);
+            TestFifoBroadcast(dataSize, offsets[offsetIndex], true);
+            if (dataSize >= 16) {
+                TestFifoPacket(dataSize, offsets[offsetIndex]);
+            }
+            if ((dataSize & (dataSize - 1)) == 0) {
+                TestFifoPow2(dataSize, offsets[offsetIndex]);
+            }
+        }
+    }
+    for (size_t offset = 0; offset <= TYPED_FIFO_CAPACITY; offset++) {
+        TestTypedFifo(offset);
+    }
+    printf("%u checks, %u failures\n", numberOfChecks, numberOfFailures);
+    return numberOfFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Records the result of a check.
+ * @param condition Condition.
+ * @param expression Expression.
+ * @param file File.
+ * @param line Line.
+ */
+static void Check(const bool condition, const char* const expression, const char* const file, const int line) {
+    numberOfChecks++;
+    if (condition) {
+        return;
+    }
+    if (numberOfFailures++ < 20) {
+        printf("%s:%d: check failed: %s\n", file, line, expression);
+    }
+}
+
+/**
+ * @brief Returns a pseudo-random number. The sequence is the same for each run
+ * so that failures are reproducible.
+ * @return Pseudo-random number.
+ */
+static uint32_t Random(void) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+/**
+ * @brief Returns a byte of the reference stream.
+ * @param index Index of the byte in the stream.
+ * @return Byte.
+ */
+static uint8_t StreamByte(const uint64_t index) {
+    return (uint8_t) ((index * 31) ^ (index >> 8));
+}
+
+/**
+ * @brief Fills a buffer with the next bytes of the reference stream.
+ * @param stream Stream.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void StreamFill(Stream * const stream, uint8_t * const data, const size_t numberOfBytes) {
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        data[index] = StreamByte(stream->written + index);
+    }
+}
+
+/**
+ * @brief Verifies that the data is the next bytes of the reference stream.
+ * @param stream Stream.
+ * @param data Data.
+ * @param numberOfBytes Number of bytes.
+ */
+static void StreamVerify(Stream * const stream, const uint8_t * const data, const size_t numberOfBytes) {
+    bool match = true;
+    for (size_t index = 0; index < numberOfBytes; index++) {
+        if (data[index] != StreamByte(stream->read + index)) {
+            match = false;
+        }
+    }
+    CHECK(match);
+    stream->read += numberOfBytes;
+}
+
+/**
+ * @brief Tests Fifo byte stream functions.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestFifo(const size_t dataSize, const size_t offset) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    Stream stream = {0};
+    uint8_t buffer[MAX_DATA_SIZE + 1];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t used = (size_t) (stream.written - stream.read);
+        CHECK(FifoAvailableRead(&fifo) == used);
+        CHECK(FifoAvailableWrite(&fifo) == (FifoCapacity(&fifo) - used));
+        const size_t numberOfBytes = Random() % (dataSize + 1);
+        switch (Random() % 9) {
+            case 0: // write
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoWrite(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    CHECK(numberOfBytes <= (FifoCapacity(&fifo) - used));
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (FifoCapacity(&fifo) - used));
+                }
+                break;
+            case 1: // write vector
+            {
+                StreamFill(&stream, buffer, numberOfBytes);
+                const size_t split = numberOfBytes == 0 ? 0 : Random() % numberOfBytes;
+                const FifoVector vectors[] = {
+                    {.data = buffer, .numberOfBytes = split},
+                    {.data = &buffer[split], .numberOfBytes = numberOfBytes - split},
+                };
+                if (FifoWritev(&fifo, vectors, 2) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (FifoCapacity(&fifo) - used));
+                }
+                break;
+            }
+            case 2: // write bytes
+                StreamFill(&stream, buffer, numberOfBytes);
+                for (size_t index = 0; index < numberOfBytes; index++) {
+                    if (FifoWriteByte(&fifo, buffer[index]) != FifoResultOk) {
+                        break;
+                    }
+                    stream.written++;
+                }
+                break;
+            case 3: // write pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoWritePointer(&fifo, &pointer, &available);
+                CHECK(available <= (FifoCapacity(&fifo) - used));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamFill(&stream, (uint8_t*) pointer, size);
+                FifoWritePointerComplete(&fifo, size);
+                stream.written += size;
+                break;
+            }
+            case 4: // read
+            {
+                const size_t size = FifoRead(&fifo, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            case 5: // read bytes
+            {
+                const size_t size = numberOfBytes < used ? numberOfBytes : used;
+                for (size_t index = 0; index < size; index++) {
+                    buffer[index] = FifoReadByte(&fifo);
+                }
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            case 6: // read pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoReadPointer(&fifo, &pointer, &available);
+                CHECK(available <= used);
+                CHECK((used == 0) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamVerify(&stream, (const uint8_t*) pointer, size);
+                FifoReadPointerComplete(&fifo, size);
+                break;
+            }
+            case 7: // peek and skip
+            {
+                const size_t size = FifoPeek(&fifo, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(&stream, buffer, size);
+                CHECK(FifoSkip(&fifo, size) == size);
+                break;
+            }
+            default: // find
+            {
+                if (used == 0) {
+                    size_t foundOffset;
+                    CHECK(FifoFind(&fifo, 0, &foundOffset) == FifoResultError);
+                    break;
+                }
+                const uint64_t target = stream.read + (Random() % used);
+                uint64_t expected = stream.read;
+                while (StreamByte(expected) != StreamByte(target)) {
+                    expected++;
+                }
+                size_t foundOffset;
+                CHECK(FifoFind(&fifo, StreamByte(target), &foundOffset) == FifoResultOk);
+                CHECK(foundOffset == (size_t) (expected - stream.read));
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests Fifo packet functions.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestFifoPacket(const size_t dataSize, const size_t offset) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    Stream stream = {0};
+    uint64_t packetsWritten = 0;
+    uint64_t packetsRead = 0;
+    uint8_t buffer[MAX_DATA_SIZE];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t numberOfBytes = 1 + (Random() % (dataSize / 4));
+        switch (Random() % 3) {
+            case 0: // write packet
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoWritePacket(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                    packetsWritten++;
+                } else {
+                    CHECK(numberOfBytes > FifoAvailableWritePacket(&fifo));
+                }
+                break;
+            case 1: // read packet
+            {
+                const size_t size = FifoReadPacket(&fifo, buffer, sizeof (buffer));
+                CHECK((size == 0) == (packetsRead == packetsWritten));
+                if (size > 0) {
+                    StreamVerify(&stream, buffer, size);
+                    packetsRead++;
+                }
+                break;
+            }
+            default: // read packets
+            {
+                const size_t size = FifoReadPackets(&fifo, buffer, sizeof (buffer));
+                CHECK(size == (size_t) (stream.written - stream.read));
+                StreamVerify(&stream, buffer, size);
+                packetsRead = packetsWritten;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests FifoPow2 functions.
+ * @param dataSize Data size. Must be a power of two.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestFifoPow2(const size_t dataSize, const size_t offset) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    FifoPow2 fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset};
+    Stream stream = {0};
+    uint8_t buffer[MAX_DATA_SIZE + 1];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t used = (size_t) (stream.written - stream.read);
+        CHECK(FifoPow2AvailableRead(&fifo) == used);
+        CHECK(FifoPow2AvailableWrite(&fifo) == (dataSize - used));
+        const size_t numberOfBytes = Random() % (dataSize + 2);
+        switch (Random() % 6) {
+            case 0: // write
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoPow2Write(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    CHECK(numberOfBytes <= (dataSize - used));
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (dataSize - used));
+                }
+                break;
+            case 1: // write bytes
+                StreamFill(&stream, buffer, numberOfBytes);
+                for (size_t index = 0; index < numberOfBytes; index++) {
+                    if (FifoPow2WriteByte(&fifo, buffer[index]) != FifoResultOk) {
+                        break;
+                    }
+                    stream.written++;
+                }
+                break;
+            case 2: // write pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoPow2WritePointer(&fifo, &pointer, &available);
+                CHECK(available <= (dataSize - used));
+                CHECK((used == dataSize) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamFill(&stream, (uint8_t*) pointer, size);
+                FifoPow2WritePointerComplete(&fifo, size);
+                stream.written += size;
+                break;
+            }
+            case 3: // read
+            {
+                const size_t size = FifoPow2Read(&fifo, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            case 4: // read bytes
+            {
+                const size_t size = numberOfBytes < used ? numberOfBytes : used;
+                for (size_t index = 0; index < size; index++) {
+                    buffer[index] = FifoPow2ReadByte(&fifo);
+                }
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            default: // read pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoPow2ReadPointer(&fifo, &pointer, &available);
+                CHECK(available <= used);
+                CHECK((used == 0) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamVerify(&stream, (const uint8_t*) pointer, size);
+                FifoPow2ReadPointerComplete(&fifo, size);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests FifoBip functions.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestFifoBip(const size_t dataSize, const size_t offset) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    FifoBip fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset, .endIndex = dataSize};
+    Stream stream = {0};
+    uint8_t buffer[MAX_DATA_SIZE + 1];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t used = (size_t) (stream.written - stream.read);
+        CHECK(FifoBipAvailableRead(&fifo) == used);
+        const size_t availableWrite = FifoBipAvailableWrite(&fifo);
+        CHECK((availableWrite + used) <= dataSize);
+        const size_t numberOfBytes = Random() % (dataSize + 1);
+        switch (Random() % 4) {
+            case 0: // write
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoBipWrite(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > availableWrite);
+                }
+                break;
+            case 1: // write vector
+            {
+                StreamFill(&stream, buffer, numberOfBytes);
+                const size_t split = numberOfBytes == 0 ? 0 : Random() % numberOfBytes;
+                const FifoVector vectors[] = {
+                    {.data = buffer, .numberOfBytes = split},
+                    {.data = &buffer[split], .numberOfBytes = numberOfBytes - split},
+                };
+                if (FifoBipWritev(&fifo, vectors, 2) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > availableWrite);
+                }
+                break;
+            }
+            case 2: // read
+            {
+                const size_t size = FifoBipRead(&fifo, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            default: // read pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoBipReadPointer(&fifo, &pointer, &available);
+                CHECK(available <= used);
+                CHECK((used == 0) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamVerify(&stream, (const uint8_t*) pointer, size);
+                FifoBipReadPointerComplete(&fifo, size);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests Fifo multiple producer functions. A producer preempted by
+ * another producer is simulated by incrementing the number of writes in
+ * progress before the preempting write.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestFifoMultiProducer(const size_t dataSize, const size_t offset) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    Fifo fifo = {.data = fifoData, .dataSize = dataSize, .readIndex = offset, .writeIndex = offset, .reserveIndex = offset};
+    Stream stream = {0};
+    uint8_t buffer[MAX_DATA_SIZE + 1];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t used = (size_t) (stream.written - stream.read);
+        CHECK(fifo.writesInProgress == 0);
+        CHECK(FifoAvailableRead(&fifo) == used);
+        CHECK(FifoAvailableWriteMultiProducer(&fifo) == (FifoCapacity(&fifo) - used));
+        const size_t numberOfBytes = Random() % (dataSize + 1);
+        switch (Random() % 5) {
+            case 0: // write
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoWriteMultiProducer(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    CHECK(numberOfBytes <= (FifoCapacity(&fifo) - used));
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (FifoCapacity(&fifo) - used));
+                }
+                break;
+            case 1: // write vector
+            {
+                StreamFill(&stream, buffer, numberOfBytes);
+                const size_t split = numberOfBytes == 0 ? 0 : Random() % numberOfBytes;
+                const FifoVector vectors[] = {
+                    {.data = buffer, .numberOfBytes = split},
+                    {.data = &buffer[split], .numberOfBytes = numberOfBytes - split},
+                };
+                if (FifoWritevMultiProducer(&fifo, vectors, 2) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (FifoCapacity(&fifo) - used));
+                }
+                break;
+            }
+            case 2: // write preempting another producer
+            {
+                fifo.writesInProgress++;
+                StreamFill(&stream, buffer, numberOfBytes);
+                if (FifoWriteMultiProducer(&fifo, buffer, numberOfBytes) == FifoResultOk) {
+                    stream.written += numberOfBytes;
+                } else {
+                    CHECK(numberOfBytes > (FifoCapacity(&fifo) - used));
+                }
+                CHECK(FifoAvailableRead(&fifo) == used); // not visible until preempted producer completes
+                CHECK(FifoAvailableWriteMultiProducer(&fifo) == (FifoCapacity(&fifo) - (size_t) (stream.written - stream.read)));
+                fifo.writesInProgress--;
+                const size_t preemptedNumberOfBytes = Random() % (dataSize + 1);
+                const size_t preemptedAvailable = FifoCapacity(&fifo) - (size_t) (stream.written - stream.read);
+                StreamFill(&stream, buffer, preemptedNumberOfBytes);
+                if (FifoWriteMultiProducer(&fifo, buffer, preemptedNumberOfBytes) == FifoResultOk) {
+                    CHECK(preemptedNumberOfBytes <= preemptedAvailable);
+                    stream.written += preemptedNumberOfBytes;
+                } else {
+                    CHECK(preemptedNumberOfBytes > preemptedAvailable);
+                }
+                CHECK(FifoAvailableRead(&fifo) == (size_t) (stream.written - stream.read));
+                break;
+            }
+            case 3: // read
+            {
+                const size_t size = FifoRead(&fifo, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(&stream, buffer, size);
+                break;
+            }
+            default: // read pointer
+            {
+                volatile void* pointer;
+                size_t available;
+                FifoReadPointer(&fifo, &pointer, &available);
+                CHECK(available <= used);
+                CHECK((used == 0) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                StreamVerify(&stream, (const uint8_t*) pointer, size);
+                FifoReadPointerComplete(&fifo, size);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests FifoBroadcast functions. Each reader is verified against the
+ * same reference stream and a dropped reader is expected to resume from the
+ * newest data.
+ * @param dataSize Data size.
+ * @param offset Initial position of the read and write indexes.
+ * @param dropSlowReaders True if slow readers are dropped.
+ */
+static void TestFifoBroadcast(const size_t dataSize, const size_t offset, const bool dropSlowReaders) {
+    static uint8_t fifoData[MAX_DATA_SIZE];
+    FifoBroadcastReader fifoReaders[NUMBER_OF_BROADCAST_READERS];
+    for (size_t index = 0; index < NUMBER_OF_BROADCAST_READERS; index++) {
+        fifoReaders[index] = (FifoBroadcastReader) {.readIndex = offset};
+    }
+    FifoBroadcast fifo = {.data = fifoData, .dataSize = dataSize, .readers = fifoReaders, .numberOfReaders = NUMBER_OF_BROADCAST_READERS, .dropSlowReaders = dropSlowReaders, .writeIndex = offset};
+    Stream stream = {0};
+    Stream readers[NUMBER_OF_BROADCAST_READERS] = {{0}};
+    bool dropped[NUMBER_OF_BROADCAST_READERS] = {false};
+    uint32_t numberOfDrops[NUMBER_OF_BROADCAST_READERS] = {0};
+    uint8_t buffer[MAX_DATA_SIZE + 1];
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        size_t availableWrite = FifoBroadcastCapacity(&fifo);
+        for (size_t index = 0; index < NUMBER_OF_BROADCAST_READERS; index++) {
+            const size_t used = (size_t) (stream.written - readers[index].read);
+            if ((dropped[index] == false) && ((FifoBroadcastCapacity(&fifo) - used) < availableWrite)) {
+                availableWrite = FifoBroadcastCapacity(&fifo) - used;
+            }
+        }
+        CHECK(FifoBroadcastAvailableWrite(&fifo) == availableWrite);
+        const size_t readerIndex = Random() % NUMBER_OF_BROADCAST_READERS;
+        Stream * const reader = &readers[readerIndex];
+        const size_t numberOfBytes = Random() % (dataSize + 1);
+        switch (Random() % 6) {
+            case 0: // write
+            case 1:
+                TestFifoBroadcastWrite(&fifo, &stream, readers, dropped, numberOfBytes);
+                break;
+            case 2: // read
+            {
+                TestFifoBroadcastResynchronise(&stream, reader, &dropped[readerIndex], &numberOfDrops[readerIndex]);
+                const size_t used = (size_t) (stream.written - reader->read);
+                CHECK(FifoBroadcastAvailableRead(&fifo, readerIndex) == used);
+                const size_t size = FifoBroadcastRead(&fifo, readerIndex, buffer, numberOfBytes);
+                CHECK(size == (numberOfBytes < used ? numberOfBytes : used));
+                StreamVerify(reader, buffer, size);
+                break;
+            }
+            case 3: // read pointer preempted by write
+            {
+                TestFifoBroadcastResynchronise(&stream, reader, &dropped[readerIndex], &numberOfDrops[readerIndex]);
+                const size_t used = (size_t) (stream.written - reader->read);
+                volatile void* pointer;
+                size_t available;
+                FifoBroadcastReadPointer(&fifo, readerIndex, &pointer, &available);
+                CHECK(available <= used);
+                CHECK((used == 0) || (available > 0));
+                const size_t size = numberOfBytes < available ? numberOfBytes : available;
+                TestFifoBroadcastWrite(&fifo, &stream, readers, dropped, Random() % (dataSize + 1));
+                if (dropped[readerIndex]) {
+                    CHECK(FifoBroadcastReadPointerComplete(&fifo, readerIndex, size) == FifoResultError);
+                    break;
+                }
+                StreamVerify(reader, (const uint8_t*) pointer, size);
+                CHECK(FifoBroadcastReadPointerComplete(&fifo, readerIndex, size) == FifoResultOk);
+                break;
+            }
+            case 4: // number of drops
+                TestFifoBroadcastResynchronise(&stream, reader, &dropped[readerIndex], &numberOfDrops[readerIndex]);
+                CHECK(FifoBroadcastNumberOfDrops(&fifo, readerIndex) == numberOfDrops[readerIndex]);
+                numberOfDrops[readerIndex] = 0;
+                break;
+            default: // clear
+                TestFifoBroadcastResynchronise(&stream, reader, &dropped[readerIndex], &numberOfDrops[readerIndex]);
+                FifoBroadcastClear(&fifo, readerIndex);
+                reader->read = stream.written;
+                break;
+        }
+    }
+    if (dropSlowReaders == false) {
+        for (size_t index = 0; index < NUMBER_OF_BROADCAST_READERS; index++) {
+            CHECK(FifoBroadcastNumberOfDrops(&fifo, index) == 0);
+        }
+    }
+}
+
+/**
+ * @brief Writes to the broadcast FIFO and updates the expected state of each
+ * reader.
+ * @param fifo FIFO structure.
+ * @param stream Writer stream.
+ * @param readers Reader streams.
+ * @param dropped Reader dropped flags.
+ * @param numberOfBytes Number of bytes.
+ */
+static void TestFifoBroadcastWrite(FifoBroadcast * const fifo, Stream * const stream, Stream * const readers, bool * const dropped, const size_t numberOfBytes) {
+    static uint8_t buffer[MAX_DATA_SIZE + 1];
+    const size_t capacity = FifoBroadcastCapacity(fifo);
+    bool fits = numberOfBytes <= capacity;
+    for (size_t index = 0; index < NUMBER_OF_BROADCAST_READERS; index++) {
+        if ((dropped[index] == false) && (numberOfBytes > (capacity - (size_t) (stream->written - readers[index].read)))) {
+            fits = false;
+        }
+    }
+    const bool expected = fits || (fifo->dropSlowReaders && (numberOfBytes <= capacity));
+    StreamFill(stream, buffer, numberOfBytes);
+    const size_t split = numberOfBytes == 0 ? 0 : Random() % numberOfBytes;
+    const FifoVector vectors[] = {
+        {.data = buffer, .numberOfBytes = split},
+        {.data = &buffer[split], .numberOfBytes = numberOfBytes - split},
+    };
+    const FifoResult result = (Random() % 2) == 0 ? FifoBroadcastWrite(fifo, buffer, numberOfBytes) : FifoBroadcastWritev(fifo, vectors, 2);
+    CHECK((result == FifoResultOk) == expected);
+    if (result != FifoResultOk) {
+        return;
+    }
+    if (fits == false) {
+        for (size_t index = 0; index < NUMBER_OF_BROADCAST_READERS; index++) {
+            if (numberOfBytes > (capacity - (size_t) (stream->written - readers[index].read))) {
+                dropped[index] = true;
+            }
+        }
+    }
+    stream->written += numberOfBytes;
+}
+
+/**
+ * @brief Updates the expected state of a reader for a function that
+ * resynchronises a dropped reader with the writer.
+ * @param stream Writer stream.
+ * @param reader Reader stream.
+ * @param dropped Reader dropped flag.
+ * @param numberOfDrops Expected number of drops.
+ */
+static void TestFifoBroadcastResynchronise(Stream * const stream, Stream * const reader, bool * const dropped, uint32_t * const numberOfDrops) {
+    if (*dropped == false) {
+        return;
+    }
+    reader->read = stream->written;
+    *dropped = false;
+    (*numberOfDrops)++;
+}
+
+/**
+ * @brief Tests FIFO_TYPED functions. Each element is its index in the stream
+ * so that discarded elements are detected.
+ * @param offset Initial position of the read and write indexes.
+ */
+static void TestTypedFifo(const size_t offset) {
+    TypedFifo fifo = {.readIndex = offset, .writeIndex = offset};
+    Stream stream = {0};
+    for (int operation = 0; operation < NUMBER_OF_OPERATIONS; operation++) {
+        const size_t used = (size_t) (stream.written - stream.read);
+        CHECK(TypedFifoAvailableRead(&fifo) == used);
+        CHECK(TypedFifoAvailableWrite(&fifo) == (TYPED_FIFO_CAPACITY - used));
+        switch (Random() % 7) {
+            case 0: // write
+            case 1:
+            {
+                const uint64_t element = stream.written;
+                if (TypedFifoWrite(&fifo, &element) == FifoResultOk) {
+                    CHECK(used < TYPED_FIFO_CAPACITY);
+                    stream.written++;
+                } else {
+                    CHECK(used == TYPED_FIFO_CAPACITY);
+                }
+                break;
+            }
+            case 2: // write overwrite
+            case 3:
+            {
+                const uint64_t element = stream.written;
+                const uint32_t numberOfElementsDiscarded = TypedFifoWriteOverwrite(&fifo, &element);
+                CHECK(numberOfElementsDiscarded == (used == TYPED_FIFO_CAPACITY ? 1 : 0));
+                stream.read += numberOfElementsDiscarded;
+                stream.written++;
+                break;
+            }
+            case 4: // read
+            case 5:
+            {
+                uint64_t element;
+                if (TypedFifoRead(&fifo, &element) == FifoResultOk) {
+                    CHECK(element == stream.read);
+                    stream.read++;
+                } else {
+                    CHECK(used == 0);
+                }
+                break;
+            }
+            default: // clear
+                TypedFifoClear(&fifo);
+                stream.read = stream.written;
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// End of file